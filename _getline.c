@@ -1,51 +1,69 @@
 #include "shell.h"
 
+static reader_t *readers[MAX_READER_FD]; /* one reader per file descriptor */
+
 /**
- * _getline - reads input from a file descriptor
- * @lineptr: a pointer to the string buffer
- * @n: number of bytes written
+ * _getline - reads a line from a file descriptor
+ * @lineptr: a pointer to the string buffer, it is (re)allocated as needed and
+ * can be reused for the next lines
+ * @n: a pointer to the size of the *@lineptr buffer
  * @fd: file descriptor
  *
- * Return: the number of bytes on success, else -1 on error
+ * Description: Every file descriptor gets its own persistent input buffer,
+ * much like a stdio stream but owned by the shell. Input is read in large
+ * blocks and whatever comes after the end of the line is kept for the next
+ * call, so exactly one line is returned per call and a burst of lines costs a
+ * single read().
+ *
+ * Return: the number of bytes on success, 0 at the end of the input, else -1
+ * on error
  */
 ssize_t _getline(char **lineptr, size_t *n, int fd)
 {
-	ssize_t n_read;
-	size_t total_read, buffer_size = BUFF_SIZE;
-
-	if (*lineptr == NULL) /* check if we should allocate memory */
-	{
-		*lineptr = malloc(sizeof(char) * (buffer_size + 1));
-		if (*lineptr == NULL)
-			return (-1); /* memory allocation failed */
-	}
-	n_read = total_read = 0;
-	while ((n_read = read(fd, *lineptr + total_read, BUFF_SIZE)) > 0)
-	{
-		total_read += n_read;
-		/* check if the buffer needs to be resized */
-		if (total_read >= buffer_size)
-		{
-			buffer_size *= 2;
-			*lineptr = _realloc(*lineptr, total_read, buffer_size);
-			if (*lineptr == NULL)
-				return (-1); /* resizing buffer memory failed */
-			*n = total_read;
-		}
-		if (total_read && (*lineptr)[total_read - 1] == '\n')
-		{
-			(*lineptr)[total_read] = '\0';
-			*n = total_read;
-			return (total_read);
-		}
-	}
-	if (n_read == -1)
-	{
-		safe_free(*lineptr);
-		return (-1); /* reading from file descriptor failed */
-	}
-	if (total_read == 0)
-		safe_free(*lineptr); /* nothing was read, free the memory */
-
-	return (total_read);
+	reader_t *reader = get_reader(fd);
+
+	if (reader == NULL)
+		return (-1);
+
+	return (read_line(reader, lineptr, n));
+}
+
+/**
+ * get_reader - returns the reader of a file descriptor, creating it when the
+ * file descriptor is read for the first time
+ * @fd: the file descriptor
+ *
+ * Return: the reader, else NULL on failure
+ */
+reader_t *get_reader(int fd)
+{
+	if (fd < 0 || fd >= MAX_READER_FD)
+		return (NULL);
+
+	if (readers[fd] == NULL)
+		readers[fd] = new_reader(fd);
+
+	return (readers[fd]);
+}
+
+/**
+ * release_reader - frees the reader of a file descriptor, any data read ahead
+ * is discarded
+ * @fd: the file descriptor, which is left open
+ */
+void release_reader(int fd)
+{
+	if (fd >= 0 && fd < MAX_READER_FD)
+		free_reader(&readers[fd]);
+}
+
+/**
+ * free_readers - frees the readers of all the file descriptors
+ */
+void free_readers(void)
+{
+	int fd;
+
+	for (fd = 0; fd < MAX_READER_FD; fd++)
+		free_reader(&readers[fd]);
 }
@@ -64,17 +64,9 @@ char **_strtok(const char *str, const char *delim)
  */
 char *_strpbrk(const char *s, const char *accept)
 {
-	int i, j;
+	size_t len = string_span(s, accept, 0);
 
-	for (i = 0; s[i] != '\0'; i++)
-	{
-		for (j = 0; accept[j]; j++)
-		{
-			if (s[i] == accept[j])
-				return ((char *)&s[i]); /* match found*/
-		}
-	}
-	return (NULL); /* no match found or end of string - return NULL */
+	return ((s[len] != '\0') ? (char *)s + len : NULL);
 }
 
 /**
@@ -90,27 +82,11 @@ char *_strpbrk(const char *s, const char *accept)
  */
 size_t _strspn(const char *s, const char *accept)
 {
-	size_t len = 0;
-	int i, map[256] = {0};
-
 	/* handle empty arguments */
 	if (s == NULL || accept == NULL)
 		return (0);
 
-	/* use a hash map for efficient lookup - assume ASCII */
-	for (i = 0; accept[i] != '\0'; i++)
-		map[(unsigned char)accept[i]] = 1;
-
-	for (i = 0; s[i] != '\0'; i++)
-	{
-		if (s[i] == SPACE) /* search till next word */
-			break;
-		else if (map[(unsigned char)s[i]])
-			len++; /* match found, increment length */
-		else
-			break; /* no match found */
-	}
-	return (len);
+	return (string_span(s, accept, 1));
 }
 
 /**
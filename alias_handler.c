@@ -1,159 +1,149 @@
 #include "shell.h"
 
-static int exit_code;
-
 /**
- * handle_alias - handles the processing of alias
- * @head: a pointer to the list containing all aliases
- * @command: the list of commands containing alias-specific lines
+ * handle_alias - handles the alias and unalias builtins
+ * @store: the aliases
+ * @command: the command line, as written
  *
- * Return: 0 on success, -1 on error
+ * Return: the exit code of the builtin
  */
-int handle_alias(alias_t **head, char *command)
+int handle_alias(alias_store_t *store, char *command)
 {
-	while (*command == ' ')
-		command++; /* remove all the leading spaces */
-
-	if (_strlen(command) == 5)
-		print_aliases(*head);
+	while (isblank(*command))
+		command++;
 
-	else if (!_strncmp(command, "alias", 5))
-	{
-		if (!_strchr(command, '='))
-			process_non_matching(*head, command + 5, 1);
-		else
-			parse_aliases(command, head);
-	}
+	if (!_strncmp(command, "unalias", 7))
+		return (unalias(store, command));
 
-	else if (!_strncmp(command, "unalias", 7))
-		return (unalias(head, command));
+	while (*command != '\0' && !isblank(*command))
+		command++; /* the name the builtin was invoked with */
 
-	return (exit_code);
+	return (parse_aliases(command, store));
 }
 
 /**
- * parse_aliases - extract aliases from the input string using regular
- * expressions.
- * @input: the input string containing aliases
- * @aliases: a pointer to a list of aliases
+ * unquote_arg - copies an argument of the alias builtin without its quotes
+ * @arg: the start of the argument in the command line
+ * @dest: where to write the argument, large enough to hold it
+ * @equal: where to store the position of the first '=' in @dest, (size_t)-1
+ * if there is none
+ *
+ * Description: Quotes and backslashes are removed the way the shell removes
+ * them from any other word, except that parameters are left as they are, to
+ * be expanded when the alias is used.
  *
- * Description: This function uses regular expressions to extract aliases from
- * the input string. It populates the provided array of Alias structures with
- * the parsed aliases and updates the aliasCount accordingly.
+ * Return: a pointer past the end of the argument in the command line
  */
-void parse_aliases(const char *input, alias_t **aliases)
+static const char *unquote_arg(const char *arg, char *dest, size_t *equal)
 {
-	char *input_ptr = NULL;
-	size_t valueLength, alias_count = 0;
-	regmatch_t matches[3];
-	regex_t regex;
-	const char *pattern =
-		"([^\"]\\S*|\"[^\"]*\"|'[^\']*')=([^\"]\\S*|\"[^\"]*\"|'[^\']*')";
-
-	if (regcomp(&regex, pattern, REG_EXTENDED) != 0)
-		return; /* regular expression compilation failed */
-	input_ptr = (char *)input;
-	while (regexec(&regex, input_ptr, 3, matches, 0) == 0)
+	size_t len = 0;
+	char quote = '\0';
+
+	for (*equal = (size_t)-1; *arg != '\0'; arg++)
 	{
-		char name[MAX_ALIAS_LENGTH] = {0};
-		char value[MAX_VALUE_LENGTH] = {0};
-
-		/* extract the alias name, accounts for the leading spaces */
-		_strncpy(name, (input_ptr + 1) + matches[1].rm_so,
-				 (matches[1].rm_eo - 1) - matches[1].rm_so);
-		_strncpy(value, input_ptr + matches[2].rm_so,
-				 matches[2].rm_eo - matches[2].rm_so); /* extract the alias value */
-		name[matches[1].rm_eo - matches[1].rm_so] = '\0';
-
-		valueLength = matches[2].rm_eo - matches[2].rm_so;
-		if (isquote(value[0])) /* remove quotes */
+		if (quote == '\0' && (isblank(*arg) || *arg == '\n'))
+			break;
+		if (*arg == quote || (quote == '\0' && isquote(*arg)))
 		{
-			_strncpy(value, input_ptr + matches[2].rm_so + 1, valueLength - 2);
-			value[valueLength - 2] = '\0';
+			quote = (quote == '\0') ? *arg : '\0';
+			continue;
 		}
-		else /* not enclosed in quotes, copy as is */
-			value[valueLength] = '\0';
-		if (add_alias(aliases, name, value) == NULL)
-			return;
-		if (alias_count)
-			process_non_matching(*aliases, input_ptr, 0);
-		alias_count++;				   /* increment alias count */
-		input_ptr += matches[0].rm_eo; /* keep searching */
+		if (*arg == '\\' && quote != '\'' && arg[1] != '\0' &&
+				(quote == '\0' || _strchr("$`\"\\\n", arg[1]) != NULL))
+			arg++; /* the next character stands for itself */
+		if (*arg == '=' && *equal == (size_t)-1)
+			*equal = len;
+		dest[len++] = *arg;
 	}
-	if (alias_count)
-		process_non_matching(*aliases, input_ptr, 1);
-	regfree(&regex);
+	dest[len] = '\0';
+
+	return (arg);
 }
 
 /**
- * process_non_matching - processes strings that do not have the `name=value`
- * format while parsing aliases
- * @aliases: a list containing aliases
- * @non_matching: the string to check for non-matching patterns
- * @end: used to signal the end. 1 means it can process the whole string at
- * once. 0 means it can do only word token at a time
+ * parse_aliases - defines or prints the aliases given to the alias builtin
+ * @args: the arguments of the builtin, as written on the command line
+ * @store: the aliases
+ *
+ * Description: The arguments are scanned in a single pass. An argument of
+ * the form name=value defines an alias, any other prints the alias it names,
+ * and all the aliases are printed when there is no argument. Names and
+ * values can be of any length.
+ *
+ * Return: 0 on success, 1 if an alias to print was not found, else -1 if
+ * memory allocation failed
  */
-void process_non_matching(alias_t *aliases, const char *non_matching, int end)
+int parse_aliases(const char *args, alias_store_t *store)
 {
-	char *token, *dup;
+	char *arg = malloc(_strlen(args) + 1);
+	size_t equal, count = 0;
+	int exit_code = 0;
 
-	if (non_matching == NULL || *non_matching == '\0')
-		return; /* there's nothing to work on, everything matched */
+	if (arg == NULL)
+		return (-1);
 
-	dup = _strdup(non_matching);
-	token = strtok(dup, " ");
-
-	/* it is non-matching if it doesn't contain an equal sign */
-	if (!_strchr(token, '='))
+	while (1)
 	{
-		if (end)
+		while (isblank(*args) || *args == '\n')
+			args++;
+		if (*args == '\0')
+			break;
+		args = unquote_arg(args, arg, &equal);
+		count++;
+		if (equal == (size_t)-1 || equal == 0)
+		{
+			exit_code |= print_alias(store, arg);
+			continue;
+		}
+		arg[equal] = '\0';
+		if (add_alias(store, arg, arg + equal + 1) == NULL)
 		{
-			while (token != NULL)
-			{
-				exit_code = print_alias(aliases, token);
-				token = strtok(NULL, " ");
-			}
+			exit_code = -1;
+			break;
 		}
-		else
-			exit_code = print_alias(aliases, token);
 	}
-	free(dup);
+	if (count == 0)
+		print_aliases(store);
+	safe_free(arg);
+
+	return (exit_code);
 }
 
 /**
  * build_alias_cmd - builds the correct command line when the received input is
  * a valid alias command
- * @sub_command: a pointer to the array containing the commands
- * @alias_value: the value of the alias command
+ * @msh: contains all the data relevant to the shell's operation
+ * @alias_words: the words the alias expands to
+ *
+ * Description: The words of the alias replace the alias in msh->sub_command,
+ * the array is allocated from the shell's arena and the words are shared.
  */
-void build_alias_cmd(char ***sub_command, char *alias_value)
+void build_alias_cmd(shell_t *msh, char **alias_words)
 {
-	char **dup_array = NULL;
+	char **command = copy_words(&msh->arena, alias_words, msh->sub_command + 1);
 
-	if ((*sub_command)[1] != NULL)
+	if (command == NULL)
 	{
-		/* save a copy of the the commands array, excluding the alias */
-		dup_array = duplicate_str_array((*sub_command) + 1);
-		if (dup_array == NULL)
-		{
-			fprintf(stderr, "alias: Memory allocation failed\n");
-			return;
-		}
+		fflush(stdout); /* keep the output in order */
+		fprintf(stderr, "alias: Memory allocation failed\n");
+		return;
+	}
+	msh->sub_command = command;
+}
 
-		/* memory and build the command line string based on the alias value */
-		free_str(sub_command);
-		*sub_command = _strtok(alias_value, NULL);
+/**
+ * expand_alias - replaces the command name with its alias value if it is one
+ * @msh: contains all the data relevant to the shell's operation
+ */
+void expand_alias(shell_t *msh)
+{
+	char **alias_words;
 
-		/* concatenate both arrays to form a complete command string */
-		concatenate_arrays(sub_command, dup_array);
+	if (msh->aliases.count == 0 || msh->sub_command[0] == NULL)
+		return; /* the common case, nothing to look up */
 
-		/* clean up and return */
-		free_str(&dup_array);
-	}
-	else
-	{
-		/* there was alias alright but no other arguments */
-		free_str(sub_command);
-		*sub_command = _strtok(alias_value, NULL);
-	}
+	alias_words = get_alias_words(&msh->aliases, &msh->arena,
+			msh->sub_command[0]);
+	if (alias_words != NULL)
+		build_alias_cmd(msh, alias_words);
 }
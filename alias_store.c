@@ -0,0 +1,155 @@
+#include "shell.h"
+
+/**
+ * find_alias - looks up an alias
+ * @store: the aliases
+ * @name: the name of the alias, can be NULL
+ *
+ * Return: the alias if found, else NULL
+ */
+alias_t *find_alias(const alias_store_t *store, const char *name)
+{
+	size_t hash;
+	alias_t *alias;
+
+	if (store->buckets == NULL || name == NULL)
+		return (NULL);
+
+	hash = hash_string(name);
+	for (alias = store->buckets[hash & (store->size - 1)]; alias != NULL;
+			alias = alias->next)
+	{
+		if (alias->hash == hash && !_strcmp(alias->name, name))
+			return (alias);
+	}
+
+	return (NULL);
+}
+
+/**
+ * add_alias - defines an alias, or changes the value of an existing one
+ * @store: the aliases
+ * @name: the name of the alias
+ * @value: the value of the alias
+ *
+ * Return: the alias, else NULL if memory allocation failed
+ */
+alias_t *add_alias(alias_store_t *store, const char *name, const char *value)
+{
+	alias_t *alias = find_alias(store, name);
+	char *copy = _strdup(value);
+
+	if (copy == NULL)
+		return (NULL);
+	store->generation++; /* the expansions may depend on the old value */
+	if (alias != NULL)
+		return (safe_free(alias->value), alias->value = copy, alias);
+
+	if (store->count + 1 > store->size / 4 * 3 && resize_alias_store(store,
+				(store->size) ? store->size * 2 : ALIAS_MIN_BUCKETS) == -1)
+		return (safe_free(copy), NULL);
+	alias = malloc(sizeof(alias_t));
+	if (alias == NULL || (alias->name = _strdup(name)) == NULL)
+		return (safe_free(alias), safe_free(copy), NULL);
+	alias->value = copy;
+	alias->hash = hash_string(name);
+	alias->words = NULL;
+	alias->generation = alias->mark = 0;
+
+	alias->next = store->buckets[alias->hash & (store->size - 1)];
+	store->buckets[alias->hash & (store->size - 1)] = alias;
+	alias->prev_alias = store->last;
+	alias->next_alias = NULL;
+	if (store->last != NULL)
+		store->last->next_alias = alias;
+	else
+		store->first = alias;
+	store->last = alias;
+	store->count++;
+
+	return (alias);
+}
+
+/**
+ * delete_alias - removes an alias
+ * @store: the aliases
+ * @alias: the alias to remove
+ */
+void delete_alias(alias_store_t *store, alias_t *alias)
+{
+	alias_t **current = &store->buckets[alias->hash & (store->size - 1)];
+
+	while (*current != alias)
+		current = &(*current)->next;
+	*current = alias->next;
+
+	if (alias->prev_alias != NULL)
+		alias->prev_alias->next_alias = alias->next_alias;
+	else
+		store->first = alias->next_alias;
+	if (alias->next_alias != NULL)
+		alias->next_alias->prev_alias = alias->prev_alias;
+	else
+		store->last = alias->prev_alias;
+
+	store->count--;
+	store->generation++;
+	multi_free("ss", alias->name, alias->value);
+	safe_free(alias->words);
+	safe_free(alias);
+}
+
+/**
+ * resize_alias_store - changes the number of buckets of the aliases
+ * @store: the aliases
+ * @size: the new number of buckets, it must be a power of two
+ *
+ * Return: 0 on success, else -1 if memory allocation failed
+ */
+int resize_alias_store(alias_store_t *store, size_t size)
+{
+	alias_t **buckets, *alias;
+	size_t i;
+
+	buckets = malloc(sizeof(alias_t *) * size);
+	if (buckets == NULL)
+		return (-1);
+	for (i = 0; i < size; i++)
+		buckets[i] = NULL;
+
+	/* the definition order links all the aliases together */
+	for (alias = store->first; alias != NULL; alias = alias->next_alias)
+	{
+		alias->next = buckets[alias->hash & (size - 1)];
+		buckets[alias->hash & (size - 1)] = alias;
+	}
+
+	safe_free(store->buckets);
+	store->buckets = buckets;
+	store->size = size;
+
+	return (0);
+}
+
+/**
+ * free_aliases - removes all the aliases
+ * @store: the aliases
+ */
+void free_aliases(alias_store_t *store)
+{
+	alias_t *alias;
+
+	while (store->first != NULL)
+	{
+		alias = store->first;
+		store->first = alias->next_alias;
+		multi_free("ss", alias->name, alias->value);
+		safe_free(alias->words);
+		safe_free(alias);
+	}
+
+	safe_free(store->buckets);
+	store->last = NULL;
+	store->size = store->count = 0;
+	store->generation++;
+}
@@ -0,0 +1,66 @@
+#include "shell.h"
+
+#ifdef MSH_ALLOC_STATS
+
+/*
+ * Built with -DMSH_ALLOC_STATS, the shell counts every heap allocation it
+ * makes and prints the count when it exits, see bench/alloc.sh. The
+ * allocations are passed on to the C library's own allocator.
+ */
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+static size_t allocations;
+
+/**
+ * malloc - counts an allocation
+ * @size: the number of bytes to allocate
+ *
+ * Return: a pointer to the allocated memory, else NULL on failure
+ */
+void *malloc(size_t size)
+{
+	allocations++;
+
+	return (__libc_malloc(size));
+}
+
+/**
+ * calloc - counts an allocation of zeroed memory
+ * @count: the number of elements
+ * @size: the size of an element
+ *
+ * Return: a pointer to the allocated memory, else NULL on failure
+ */
+void *calloc(size_t count, size_t size)
+{
+	allocations++;
+
+	return (__libc_calloc(count, size));
+}
+
+/**
+ * realloc - counts a reallocation
+ * @ptr: the memory to resize
+ * @size: the new size, in bytes
+ *
+ * Return: a pointer to the resized memory, else NULL on failure
+ */
+void *realloc(void *ptr, size_t size)
+{
+	allocations++;
+
+	return (__libc_realloc(ptr, size));
+}
+
+/**
+ * print_alloc_stats - prints the number of heap allocations made so far
+ */
+void print_alloc_stats(void)
+{
+	dprintf(STDERR_FILENO, "msh: %lu heap allocations\n", allocations);
+}
+
+#endif /* MSH_ALLOC_STATS */
@@ -0,0 +1,134 @@
+#include "shell.h"
+
+/* the offset of the memory of a block, past its aligned header */
+#define BLOCK_DATA(block) ((char *)(block) + ARENA_ALIGN_UP(sizeof(arena_block_t)))
+
+/**
+ * arena_alloc - allocates memory from an arena
+ * @arena: the arena
+ * @size: the number of bytes to allocate
+ *
+ * Description: Memory is handed out from the current block of the arena and
+ * is only given back all at once, by arena_reset(). A new block is only
+ * allocated when the current one is full.
+ *
+ * Return: a pointer to the allocated memory, else NULL on failure
+ */
+void *arena_alloc(arena_t *arena, size_t size)
+{
+	arena_block_t *block = arena->block;
+	size_t block_size;
+	void *memory;
+
+	size = ARENA_ALIGN_UP(size);
+	if (block == NULL || block->size - block->used < size)
+	{
+		block_size = (size > ARENA_BLOCK_SIZE) ? size : ARENA_BLOCK_SIZE;
+		block = malloc(ARENA_ALIGN_UP(sizeof(arena_block_t)) + block_size);
+		if (block == NULL)
+			return (NULL);
+		block->size = block_size;
+		block->used = 0;
+		block->next = arena->block;
+		arena->block = block;
+	}
+
+	memory = BLOCK_DATA(block) + block->used;
+	block->used += size;
+
+	return (memory);
+}
+
+/**
+ * arena_strndup - copies the first bytes of a string into an arena
+ * @arena: the arena
+ * @str: the string to copy, can be NULL
+ * @len: the number of bytes to copy
+ *
+ * Return: the null-terminated copy, else NULL if @str is NULL or on failure
+ */
+char *arena_strndup(arena_t *arena, const char *str, size_t len)
+{
+	char *copy;
+
+	if (str == NULL)
+		return (NULL);
+
+	copy = arena_alloc(arena, len + 1);
+	if (copy == NULL)
+		return (NULL);
+	_memcpy(copy, str, len);
+	copy[len] = '\0';
+
+	return (copy);
+}
+
+/**
+ * arena_strdup - copies a string into an arena
+ * @arena: the arena
+ * @str: the string to copy, can be NULL
+ *
+ * Return: the copy, else NULL if @str is NULL or on failure
+ */
+char *arena_strdup(arena_t *arena, const char *str)
+{
+	return (arena_strndup(arena, str, (str == NULL) ? 0 : _strlen(str)));
+}
+
+/**
+ * arena_reset - gives back all the memory allocated from an arena
+ * @arena: the arena
+ *
+ * Description: When a line needed more than one block, the blocks are
+ * replaced with a single one large enough for all of them, so that the
+ * arena settles on one block and stops allocating. Past LINE_MEMORY_MAX, e.g.
+ * after a huge here-document, the arena goes back to a single block of
+ * ARENA_BLOCK_SIZE instead, so one line can't pin that much memory for the
+ * rest of the session.
+ */
+void arena_reset(arena_t *arena)
+{
+	arena_block_t *block = arena->block;
+	size_t size = 0;
+
+	if (block == NULL)
+		return;
+
+	if (block->next == NULL && block->size <= LINE_MEMORY_MAX)
+	{
+		block->used = 0;
+		return;
+	}
+
+	for (; block != NULL; block = block->next)
+		size += block->size;
+	free_arena(arena);
+	if (size > LINE_MEMORY_MAX)
+	{
+		size = ARENA_BLOCK_SIZE;
+		malloc_trim(0); /* the C library would keep it otherwise */
+	}
+	block = malloc(ARENA_ALIGN_UP(sizeof(arena_block_t)) + size);
+	if (block == NULL)
+		return;
+	block->size = size;
+	block->used = 0;
+	block->next = NULL;
+	arena->block = block;
+}
+
+/**
+ * free_arena - frees all the blocks of an arena
+ * @arena: the arena
+ */
+void free_arena(arena_t *arena)
+{
+	arena_block_t *next;
+
+	while (arena->block != NULL)
+	{
+		next = arena->block->next;
+		safe_free(arena->block);
+		arena->block = next;
+	}
+}
@@ -0,0 +1,66 @@
+#include "shell.h"
+
+/**
+ * run_background - starts a command in the background as a new job
+ * @msh: contains all the data relevant to the shell's operation
+ * @node: the NODE_ASYNC node of the command
+ *
+ * Description: Simple commands and pipelines are started directly, without
+ * waiting for them. Commands containing logical operators need the shell to
+ * decide what to run next, so they run in a forked copy of the shell.
+ *
+ * Return: 0 on success, else 1 if the job couldn't be started
+ */
+int run_background(shell_t *msh, node_t *node)
+{
+	node_t *command = node->left;
+	pid_t pid;
+
+	msh->job_command = node->text;
+
+	if (command->type != NODE_CMD && command->type != NODE_PIPE)
+	{
+		pid = run_subshell(msh, command);
+		msh->exit_code = (pid == -1) ? 1 : add_job(msh, pid, pid, 1);
+	}
+	else
+	{
+		msh->async = 1;
+		execute_tree(msh, command);
+		msh->async = 0;
+		msh->exit_code = 0;
+	}
+	msh->job_command = NULL;
+
+	return (msh->exit_code);
+}
+
+/**
+ * run_subshell - runs a command tree in a forked copy of the shell, in a new
+ * process group
+ * @msh: contains all the data relevant to the shell's operation
+ * @tree: the command tree to run
+ *
+ * Return: the process ID of the forked shell, else -1 if forking failed
+ */
+pid_t run_subshell(shell_t *msh, node_t *tree)
+{
+	pid_t pid;
+
+	fflush(stdout); /* don't let the child inherit our pending output */
+	pid = fork();
+	if (pid == -1)
+	{
+		perror("fork");
+		return (-1);
+	}
+	setpgid((pid == 0) ? 0 : pid, (pid == 0) ? 0 : pid);
+	if (pid != 0)
+		return (pid);
+
+	reset_child_signals(msh);
+	execute_tree(msh, tree);
+
+	fflush(stdout);
+	_exit(msh->exit_code);
+}
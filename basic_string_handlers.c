@@ -1,14 +1,14 @@
 #include "shell.h"
 
 /**
- * _strcmp - compare two strings
+ * strcmp_scalar - compare two strings
  * @s1: string 1
  * @s2: string 2
  *
  * Return: 0 if @s1 and @s2 are equal, a negative value if @s1 is
  * less than @s2, a positive value if @s1 is greater than @s2
  */
-int _strcmp(const char *s1, const char *s2)
+int strcmp_scalar(const char *s1, const char *s2)
 {
 	while (*s1 == *s2)
 	{
@@ -75,12 +75,12 @@ char *_strcpy(char *dest, const char *src)
 }
 
 /**
- * _strlen - returns the length of a string
+ * strlen_scalar - returns the length of a string
  * @s: string
  *
  * Return: length of string
  */
-size_t _strlen(const char *s)
+size_t strlen_scalar(const char *s)
 {
 	int i = 0;
 
@@ -96,36 +96,3 @@ size_t _strlen(const char *s)
 
 	return (i);
 }
-
-/**
- * get_operator - returns the && or || logical operator in a string if found
- * @str: the string to search
- *
- * Return: the logical operator if found, else NULL
- */
-char *get_operator(char *str)
-{
-	char *operator = NULL;
-	int i;
-
-	if (str == NULL)
-		return (NULL);
-
-	/* Check for the "&&" operator */
-	for (i = 0; str[i] != '\0'; i++)
-	{
-		if (str[i] == '&' && str[i + 1] == '&')
-		{
-			operator = "&&";
-			break;
-		}
-		/* Check for the "||" operator */
-		else if (str[i] == '|' && str[i + 1] == '|')
-		{
-			operator = "||";
-			break;
-		}
-	}
-
-	return (operator);
-}
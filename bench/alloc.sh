@@ -0,0 +1,45 @@
+#!/bin/sh
+#
+# alloc.sh - counts the heap allocations msh makes per command line, with a
+# build of msh that counts them (-DMSH_ALLOC_STATS). Every workload is run
+# with two script sizes; once the shell is warmed up, the parsing and
+# expansion of a line allocate nothing, so both sizes should make about the
+# same number of allocations. Pipelines are the exception: the C library
+# allocates the file actions posix_spawn() uses to connect the stages.
+#
+# Usage: bench/alloc.sh [lines]
+
+LINES=${1:-1000}
+SRC_DIR=$(cd "$(dirname "$0")/.." && pwd)
+TMP_DIR=$(mktemp -d)
+
+trap 'rm -rf "$TMP_DIR"' EXIT
+
+gcc -std=gnu89 -O2 -DMSH_ALLOC_STATS -o "$TMP_DIR/msh" "$SRC_DIR"/*.c || exit 1
+
+# write_script FILE COUNT LINE: writes a script running LINE COUNT times
+write_script() {
+	echo "alias ll='ls -d' la=ll"
+	i=0
+	while [ "$i" -lt "$2" ]; do
+		echo "$3"
+		i=$((i + 1))
+	done
+}
+
+# allocations FILE: prints the number of heap allocations of a run
+allocations() {
+	"$TMP_DIR/msh" < "$1" 2>&1 > /dev/null | sed -n 's/^msh: \([0-9]*\) heap allocations$/\1/p'
+}
+
+printf "%-34s %10s %10s %12s\n" "line" "x$LINES" "x$((LINES * 10))" "allocs/line"
+for line in 'ls /' 'la / $HOME' 'echo $? $$ $PATH' \
+	'true && ls / || false; true' 'echo a | cat'; do
+	write_script "$TMP_DIR/small" "$LINES" "$line" > "$TMP_DIR/small"
+	write_script "$TMP_DIR/large" "$((LINES * 10))" "$line" > "$TMP_DIR/large"
+	small=$(allocations "$TMP_DIR/small")
+	large=$(allocations "$TMP_DIR/large")
+	awk -v line="$line" -v small="$small" -v large="$large" -v n="$LINES" \
+		'BEGIN { printf "%-34s %10d %10d %12.2f\n", line, small, large,
+			(large - small) / (9 * n) }'
+done
@@ -0,0 +1,81 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_COMMANDS 10000 /* the commands run by most workloads */
+#define BENCH_LARGE 100000 /* the lines of the large and test scripts */
+#define BENCH_TRIALS 10
+#define BENCH_ALIASES 400 /* about the size of a shared rc file */
+#define BENCH_VARIABLES 100
+#define BENCH_MARK "echo >&3\n" /* timestamps a command line, see run_timed() */
+
+/**
+ * struct shell_spec - a shell to benchmark
+ * @name: the name of the shell as reported
+ * @path: the program to run, searched in the PATH unless it has a '/'
+ * @setenv: the printf format of a line exporting a variable
+ * @prelude: a line to put at the top of every script, NULL if none
+ */
+typedef struct shell_spec
+{
+	const char *name;
+	const char *path;
+	const char *setenv;
+	const char *prelude;
+} shell_spec_t;
+
+/**
+ * struct sample - the measurements of a single run of a shell
+ * @seconds: the wall-clock time the run took
+ * @max_rss: the peak resident set size of the shell, in KiB
+ */
+typedef struct sample
+{
+	double seconds;
+	long max_rss;
+} sample_t;
+
+/* the workloads, in the order they are run */
+enum workload
+{
+	EMPTY,
+	EXTERNAL,
+	BUILTIN,
+	ALIAS,
+	DEFINE,
+	VARIABLE,
+	CHAIN,
+	TEST,
+	LARGE,
+	WORKLOADS
+};
+
+extern const char *workload_names[WORKLOADS];
+
+long write_script(const char *path, const shell_spec_t *shell, int workload,
+		size_t *marks);
+size_t write_workload(FILE *script, const shell_spec_t *shell, int workload,
+		size_t *marks);
+void write_setup(FILE *script, const shell_spec_t *shell, int workload);
+size_t write_line(FILE *script, size_t i, int workload);
+
+size_t run_timed(const shell_spec_t *shell, const char *script,
+		double *samples, size_t marks);
+int time_lines(const shell_spec_t *shell, int workload, const char *script,
+		double mark, double *latency);
+double percentile(double *samples, size_t count, int p);
+
+#endif /* BENCH_H */
@@ -0,0 +1,38 @@
+#!/bin/sh
+#
+# env.sh - compares the in-shell `env` builtin with the way msh used to print
+# the environment: writing "env" to a file and running it with /bin/sh.
+#
+# Usage: bench/env.sh [iterations]
+
+ITERATIONS=${1:-2000}
+SRC_DIR=$(cd "$(dirname "$0")/.." && pwd)
+TMP_DIR=$(mktemp -d)
+
+trap 'rm -rf "$TMP_DIR"' EXIT
+
+gcc -std=gnu89 -O2 -o "$TMP_DIR/msh" "$SRC_DIR"/*.c || exit 1
+
+echo "env" > "$TMP_DIR/env"
+
+i=0
+while [ "$i" -lt "$ITERATIONS" ]; do
+	echo "env"
+	i=$((i + 1))
+done > "$TMP_DIR/builtin"
+
+i=0
+while [ "$i" -lt "$ITERATIONS" ]; do
+	echo "/bin/sh $TMP_DIR/env"
+	i=$((i + 1))
+done > "$TMP_DIR/fork"
+
+echo "$ITERATIONS iterations, $(env | wc -l) variables"
+
+for path in builtin fork; do
+	start=$(date +%s%N)
+	"$TMP_DIR/msh" < "$TMP_DIR/$path" > /dev/null
+	end=$(date +%s%N)
+	awk -v path="$path" -v n="$ITERATIONS" -v ns=$((end - start)) \
+		'BEGIN { printf "%-8s %10.2f us/env\n", path, ns / n / 1e3 }'
+done
@@ -0,0 +1,169 @@
+#include "bench.h"
+
+/**
+ * compare_doubles - orders two doubles for qsort()
+ * @a: a pointer to the first double
+ * @b: a pointer to the second double
+ *
+ * Return: a negative number, 0 or a positive number if the first double is
+ * smaller, equal or larger
+ */
+static int compare_doubles(const void *a, const void *b)
+{
+	double x = *(const double *)a, y = *(const double *)b;
+
+	return ((x > y) - (x < y));
+}
+
+/**
+ * read_marks - timestamps the marks a shell writes as it runs a script
+ * @fd: the read end of the pipe the marks are written to
+ * @samples: where to store the time between consecutive marks, in seconds
+ * @marks: the number of marks the script writes
+ *
+ * Description: The first mark only starts the clock. Marks read together
+ * share the time since the previous read evenly, which only happens when
+ * they were written closer together than one read.
+ *
+ * Return: the number of samples stored
+ */
+static size_t read_marks(int fd, double *samples, size_t marks)
+{
+	struct timespec now, last;
+	char buffer[4096];
+	size_t count = 0, i;
+	ssize_t len;
+	double elapsed;
+	int started = 0;
+
+	clock_gettime(CLOCK_MONOTONIC, &last);
+	while (count + started < marks)
+	{
+		len = read(fd, buffer, sizeof(buffer));
+		if (len == -1 && (errno == EAGAIN || errno == EINTR))
+			continue;
+		if (len <= 0)
+			break;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		elapsed = (now.tv_sec - last.tv_sec) +
+			(now.tv_nsec - last.tv_nsec) / 1e9;
+		for (i = !started; i < (size_t)len && count + 1 < marks; i++)
+			samples[count++] = (started) ? elapsed / len : 0;
+		started = 1;
+		last = now;
+	}
+
+	return (count);
+}
+
+/**
+ * run_timed - runs a shell on a script that writes a mark to file descriptor
+ * 3 after every command line, see write_workload()
+ * @shell: the shell
+ * @script: the path of the script
+ * @samples: where to store the time every command line took, in seconds
+ * @marks: the number of marks the script writes
+ *
+ * Description: When another CPU is online, the pipe is polled without
+ * blocking, so a mark is timestamped as soon as it is written rather than
+ * when the scheduler wakes the benchmark up.
+ *
+ * Return: the number of samples stored, else 0 if the shell failed
+ */
+size_t run_timed(const shell_spec_t *shell, const char *script,
+		double *samples, size_t marks)
+{
+	int fds[2], status, fd;
+	size_t count = 0;
+	pid_t pid;
+
+	if (pipe(fds) == -1)
+		return (0);
+	pid = fork();
+	if (pid == 0)
+	{
+		fd = open("/dev/null", O_RDWR);
+		dup2(fd, STDIN_FILENO);
+		dup2(fd, STDOUT_FILENO);
+		dup2(fd, STDERR_FILENO);
+		if (fds[0] != 3)
+			close(fds[0]);
+		if (fds[1] != 3 && dup2(fds[1], 3) == 3)
+			close(fds[1]);
+		execlp(shell->path, shell->path, script, (char *)NULL);
+		_exit(127);
+	}
+	close(fds[1]);
+	if (sysconf(_SC_NPROCESSORS_ONLN) > 1)
+		fcntl(fds[0], F_SETFL, O_NONBLOCK);
+	if (pid != -1)
+		count = read_marks(fds[0], samples, marks);
+	close(fds[0]);
+	if (pid == -1 || waitpid(pid, &status, 0) == -1 ||
+			!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+		return (0);
+
+	return (count);
+}
+
+/**
+ * time_lines - measures the latency of the commands of a workload, one
+ * command line at a time
+ * @shell: the shell
+ * @workload: the workload (one of the workload enum)
+ * @script: the path to write the timed script to
+ * @mark: the cost of a mark, see write_workload(), 0 when measuring it
+ * @latency: where to store the p50 and p99 latency per command, in seconds
+ *
+ * Description: A line takes the time between the marks around it, minus the
+ * cost of a mark, divided by the commands on the line (100 for the chain
+ * workload, 2 for test). The script is run once to warm up first. For the
+ * empty workload, made of marks alone, this is the cost of a mark.
+ *
+ * Return: 0 on success, else -1 on failure
+ */
+int time_lines(const shell_spec_t *shell, int workload,
+		const char *script, double mark, double *latency)
+{
+	double *samples, per_line;
+	size_t marks = 0, count = 0;
+	long commands = write_script(script, shell, workload, &marks);
+	int i;
+
+	if (commands == -1)
+		return (-1);
+	per_line = (commands > 0) ? (double)commands / (marks - 1) : 1;
+	samples = malloc(sizeof(double) * marks);
+	if (samples != NULL && run_timed(shell, script, samples, marks) > 0)
+		count = run_timed(shell, script, samples, marks);
+	unlink(script);
+
+	for (i = 0; i < 2 && count > 0; i++)
+	{
+		latency[i] = percentile(samples, count, (i == 0) ? 50 : 99);
+		latency[i] = (latency[i] > mark) ? (latency[i] - mark) / per_line : 0;
+	}
+	free(samples);
+
+	return ((count > 0) ? 0 : -1);
+}
+
+/**
+ * percentile - returns a percentile of samples
+ * @samples: the samples, they are sorted in place
+ * @count: the number of samples, at least 1
+ * @p: the percentile, from 1 to 100
+ *
+ * Description: The nearest-rank method is used: the result is always one of
+ * the samples.
+ *
+ * Return: the smallest sample that at least @p percents of them don't exceed
+ */
+double percentile(double *samples, size_t count, int p)
+{
+	size_t rank = (p * count + 99) / 100;
+
+	qsort(samples, count, sizeof(double), compare_doubles);
+
+	return (samples[rank - 1]);
+}
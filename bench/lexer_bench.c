@@ -0,0 +1,113 @@
+#include <time.h>
+#include "shell.h"
+
+#define CORPUS_SIZE (1 << 20) /* bytes of command lines */
+#define ROUNDS 20
+
+static const char *const samples[] = {
+	"ls -l /usr/local/bin\n",
+	"cd /var/log && grep -i error syslog | sort | uniq -c || echo none\n",
+	"alias ll='ls -alF'; ll /tmp # list the temporary files\n",
+	"make -j8 all >/dev/null 2>&1 &\n",
+	"\tsetenv PATH /opt/app/bin:/usr/bin:/bin ; echo $PATH $? $$\n",
+	"# a comment line that is skipped entirely by the shell\n",
+	"tar czf backup.tar.gz /home/user/documents /home/user/pictures\n"
+};
+
+/**
+ * now - returns the time of a monotonic clock
+ *
+ * Return: the time, in seconds
+ */
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (ts.tv_sec + ts.tv_nsec / 1e9);
+}
+
+/**
+ * build_corpus - builds the command lines the tokenizers are run on
+ * @count: where to store the number of lines
+ *
+ * Return: a NULL-terminated array of lines, else NULL on failure
+ */
+static char **build_corpus(size_t *count)
+{
+	size_t n = sizeof(samples) / sizeof(samples[0]), bytes = 0, i;
+	char **lines = malloc(sizeof(char *) * (CORPUS_SIZE / 16));
+
+	for (i = 0; lines != NULL && bytes < CORPUS_SIZE; i++)
+	{
+		lines[i] = (char *)samples[i % n];
+		bytes += _strlen(lines[i]);
+	}
+	if (lines != NULL)
+		lines[i] = NULL;
+	*count = i;
+
+	return (lines);
+}
+
+/**
+ * report - prints the throughput of a tokenizer
+ * @name: the name of the tokenizer
+ * @bytes: the number of bytes tokenized
+ * @tokens: the number of tokens produced
+ * @seconds: the time it took
+ */
+static void report(const char *name, size_t bytes, size_t tokens,
+		double seconds)
+{
+	printf("%-28s %10.1f MB/s %10.1f Mtokens/s\n", name,
+			bytes / seconds / 1e6, tokens / seconds / 1e6);
+}
+
+/**
+ * main - measures the throughput of the command line lexer, along with the
+ * whitespace splitting done by _strtok(), which used to be one of the three
+ * passes every line went through, with the string primitives the shell would
+ * pick for this CPU
+ *
+ * Return: 0 on success, else 1
+ */
+int main(void)
+{
+	size_t count, bytes = 0, tokens = 0, i, n, round;
+	char **lines, **words;
+	lexer_t lexer = {NULL, NULL, 0, 0, 0};
+	double start;
+
+	init_string_ops();
+	lines = build_corpus(&count);
+	if (lines == NULL)
+		return (1);
+	for (i = 0; i < count; i++)
+		bytes += _strlen(lines[i]);
+
+	start = now();
+	for (round = 0; round < ROUNDS; round++)
+		for (i = 0; i < count; i++)
+			if (lex_line(&lexer, lines[i]) == 0)
+				tokens += lexer.count;
+	report("lex_line (single pass)", bytes * ROUNDS, tokens, now() - start);
+
+	tokens = 0;
+	start = now();
+	for (round = 0; round < ROUNDS; round++)
+		for (i = 0; i < count; i++)
+		{
+			words = _strtok(lines[i], NULL);
+			for (n = 0; words != NULL && words[n] != NULL; n++)
+				tokens++;
+			free_str(&words);
+		}
+	report("_strtok (whitespace only)", bytes * ROUNDS, tokens, now() - start);
+
+	free_lexer(&lexer);
+	free(lines);
+
+	return (0);
+}
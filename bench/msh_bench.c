@@ -0,0 +1,184 @@
+#include "bench.h"
+
+/**
+ * find_program - checks whether a program can be run
+ * @path: the program, searched in the PATH unless it contains a '/'
+ *
+ * Return: 1 if it can be run, else 0
+ */
+static int find_program(const char *path)
+{
+	char buffer[4096];
+	const char *dirs = getenv("PATH"), *end;
+	size_t len;
+
+	if (strchr(path, '/') != NULL)
+		return (access(path, X_OK) == 0);
+
+	while (dirs != NULL && *dirs != '\0')
+	{
+		end = strchr(dirs, ':');
+		len = (end == NULL) ? strlen(dirs) : (size_t)(end - dirs);
+		snprintf(buffer, sizeof(buffer), "%.*s/%s", (int)len, dirs, path);
+		if (access(buffer, X_OK) == 0)
+			return (1);
+		dirs += len + (end != NULL);
+	}
+
+	return (0);
+}
+
+/**
+ * run_trial - runs a shell on a script once
+ * @shell: the shell
+ * @script: the path of the script
+ * @sample: where to store the measurements
+ *
+ * Return: 0 on success, else -1 if the shell couldn't run or failed
+ */
+static int run_trial(const shell_spec_t *shell, const char *script,
+		sample_t *sample)
+{
+	struct timespec start, end;
+	struct rusage usage;
+	int status, fd;
+	pid_t pid;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	pid = fork();
+	if (pid == 0)
+	{
+		fd = open("/dev/null", O_RDWR);
+		dup2(fd, STDIN_FILENO);
+		dup2(fd, STDOUT_FILENO);
+		dup2(fd, STDERR_FILENO);
+		execlp(shell->path, shell->path, script, (char *)NULL);
+		_exit(127);
+	}
+	if (pid == -1 || wait4(pid, &status, 0, &usage) == -1)
+		return (-1);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	sample->seconds = (end.tv_sec - start.tv_sec) +
+		(end.tv_nsec - start.tv_nsec) / 1e9;
+	sample->max_rss = usage.ru_maxrss;
+
+	return ((WIFEXITED(status) && WEXITSTATUS(status) == 0) ? 0 : -1);
+}
+
+/**
+ * bench_workload - runs a workload with a shell and prints the results
+ * @shell: the shell
+ * @workload: the workload (one of the workload enum)
+ * @trials: the number of measured runs, after one warm-up run
+ * @dir: the directory to write the script to
+ * @startup: the mean time of a run of the empty workload, subtracted from
+ * every run, and the cost of a mark, which the empty workload stores, see
+ * time_lines()
+ *
+ * Description: The mean time per command is the total time of the runs,
+ * minus the startup time of each, divided by the number of commands they
+ * ran. The percentiles come from a run of the script with a mark after every
+ * line.
+ *
+ * Return: the mean time of a run, else -1 on failure
+ */
+static double bench_workload(const shell_spec_t *shell, int workload,
+		int trials, const char *dir, double *startup)
+{
+	char script[4096], cache[4096], rate[32];
+	double total = 0, mean, latency[2] = {0, 0};
+	sample_t sample;
+	long commands, max_rss = 0;
+	int i;
+
+	snprintf(script, sizeof(script), "%s/%s.%s", dir, shell->name,
+			workload_names[workload]);
+	snprintf(cache, sizeof(cache), "%s/.%s.%s.mshc", dir, shell->name,
+			workload_names[workload]);
+	commands = write_script(script, shell, workload, NULL);
+	if (commands == -1)
+		return (-1);
+
+	for (i = -1; i < trials && run_trial(shell, script, &sample) == 0; i++)
+	{
+		total += (i >= 0) ? sample.seconds - startup[0] : 0;
+		max_rss = (sample.max_rss > max_rss) ? sample.max_rss : max_rss;
+	}
+	i = (i < trials ||
+			time_lines(shell, workload, script, startup[1], latency) == -1);
+	unlink(script);
+	unlink(cache);
+	if (i)
+		return (printf("%-10s %-6s failed\n", workload_names[workload],
+					shell->name), -1);
+
+	mean = total / trials / ((commands > 0) ? commands : 1);
+	sprintf(rate, (commands > 0) ? "%.0f" : "-", 1 / mean);
+	printf("%-10s %-6s %10s %9.2f %9.2f %12.2f %12ld\n",
+			workload_names[workload], shell->name, rate,
+			latency[0] * 1e6, latency[1] * 1e6, mean * 1e6, max_rss);
+	fflush(stdout);
+	if (workload == EMPTY)
+		startup[1] = latency[0];
+
+	return (total / trials);
+}
+
+/**
+ * main - benchmarks msh against dash and bash on a set of workloads
+ * @argc: the number of arguments
+ * @argv: the arguments, `msh_bench [-t trials] [msh]`
+ *
+ * Description: Shells that aren't installed are skipped. The startup time of
+ * every shell is measured first, with an empty script; its mean column is the
+ * time of a whole run, and its percentiles the cost of a mark.
+ *
+ * Return: 0 on success, else 1
+ */
+int main(int argc, char **argv)
+{
+	shell_spec_t shells[] = {
+		{"msh", "./msh", "setenv %s %s", NULL},
+		{"dash", "dash", "export %s=%s", NULL},
+		{"bash", "bash", "export %s=%s", "shopt -s expand_aliases"}
+	};
+	double startup[3][2] = {{0, 0}, {0, 0}, {0, 0}}, mean;
+	char dir[] = "/tmp/msh_bench.XXXXXX";
+	int trials = BENCH_TRIALS, i, workload;
+
+	for (i = 1; i < argc; i++)
+	{
+		if (!strcmp(argv[i], "-t") && i + 1 < argc)
+			trials = atoi(argv[++i]);
+		else
+			shells[0].path = argv[i];
+	}
+	if (trials < 1 || mkdtemp(dir) == NULL)
+	{
+		fprintf(stderr, "usage: %s [-t trials] [msh]\n", argv[0]);
+		return (1);
+	}
+
+	printf("%d commands per workload (%d lines for test and large), "
+			"%d runs each\n\n",
+			BENCH_COMMANDS, BENCH_LARGE, trials);
+	printf("%-10s %-6s %10s %9s %9s %12s %12s\n", "workload", "shell",
+			"cmds/s", "p50 us", "p99 us", "mean us/cmd",
+			"max RSS KiB");
+	for (workload = EMPTY; workload < WORKLOADS; workload++)
+	{
+		for (i = 0; i < 3; i++)
+		{
+			if (!find_program(shells[i].path) || (workload != EMPTY &&
+						startup[i][0] < 0))
+				continue;
+			mean = bench_workload(&shells[i], workload, trials, dir, startup[i]);
+			if (workload == EMPTY)
+				startup[i][0] = mean;
+		}
+	}
+	rmdir(dir);
+
+	return (0);
+}
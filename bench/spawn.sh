@@ -0,0 +1,56 @@
+#!/bin/sh
+#
+# spawn.sh - compares how many external commands per second msh runs when
+# they are started with posix_spawn() (the default) and with fork() + execve()
+# (built with -DMSH_FORK_EXEC).
+#
+# The script first defines a number of large aliases to grow the shell's heap,
+# since that is what makes fork() expensive in long-running sessions.
+#
+# Usage: bench/spawn.sh [commands] [aliases]
+
+COMMANDS=${1:-5000}
+ALIASES=${2:-4000}
+CFLAGS="-std=gnu89 -O2"
+SRC_DIR=$(cd "$(dirname "$0")/.." && pwd)
+TMP_DIR=$(mktemp -d)
+
+trap 'rm -rf "$TMP_DIR"' EXIT
+
+gcc $CFLAGS -o "$TMP_DIR/msh-spawn" "$SRC_DIR"/*.c || exit 1
+gcc $CFLAGS -DMSH_FORK_EXEC -o "$TMP_DIR/msh-fork" "$SRC_DIR"/*.c || exit 1
+
+# a 2000 bytes long alias value
+VALUE=$(head -c 2000 /dev/zero | tr '\0' 'x')
+
+i=0
+while [ "$i" -lt "$ALIASES" ]; do
+	echo "alias heap_$i='$VALUE'"
+	i=$((i + 1))
+done > "$TMP_DIR/heap"
+
+cp "$TMP_DIR/heap" "$TMP_DIR/script"
+i=0
+while [ "$i" -lt "$COMMANDS" ]; do
+	echo "/bin/true"
+	i=$((i + 1))
+done >> "$TMP_DIR/script"
+
+# elapsed - prints the nanoseconds msh takes to run a script fed on stdin
+elapsed()
+{
+	start=$(date +%s%N)
+	"$1" < "$2" > /dev/null
+	end=$(date +%s%N)
+	echo $((end - start))
+}
+
+echo "$COMMANDS commands, $ALIASES aliases of ${#VALUE} bytes"
+
+for engine in spawn fork; do
+	# don't count the time spent defining the aliases
+	setup=$(elapsed "$TMP_DIR/msh-$engine" "$TMP_DIR/heap")
+	total=$(elapsed "$TMP_DIR/msh-$engine" "$TMP_DIR/script")
+	awk -v engine="$engine" -v n="$COMMANDS" -v ns=$((total - setup)) \
+		'BEGIN { printf "%-6s %10.0f commands/sec\n", engine, n / (ns / 1e9) }'
+done
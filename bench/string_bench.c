@@ -0,0 +1,157 @@
+#include <time.h>
+#include "shell.h"
+
+#define MAX_LEN 65536
+#define BYTES_PER_RUN (128 << 20) /* bytes processed per measurement */
+#define ALIGNMENT 3 /* the offset of the strings from a 64-byte boundary */
+
+/**
+ * struct string_impl - a set of string primitives to measure
+ * @name: the name of the set
+ * @strlen_fn: the strlen() function
+ * @strchr_fn: the strchr() function
+ * @strcmp_fn: the strcmp() function
+ * @memcpy_fn: the memcpy() function
+ * @span_fn: the function behind strspn() and strpbrk()
+ */
+typedef struct string_impl
+{
+	const char *name;
+	size_t (*strlen_fn)(const char *s);
+	char *(*strchr_fn)(const char *s, int c);
+	int (*strcmp_fn)(const char *s1, const char *s2);
+	void *(*memcpy_fn)(void *dest, const void *src, size_t n);
+	size_t (*span_fn)(const char *s, const char *set, int in_set);
+} string_impl_t;
+
+static const size_t lengths[] = {8, 64, 512, 4096, MAX_LEN};
+
+static const char *const primitives[] = {
+	"strlen", "strchr", "strcmp", "memcpy", "strspn", "strpbrk"
+};
+
+/**
+ * span_libc - the C library's strspn() and strcspn(), as a span function
+ * @s: the string
+ * @set: the set of bytes
+ * @in_set: true for strspn(), false for strcspn()
+ *
+ * Return: the length of the prefix
+ */
+static size_t span_libc(const char *s, const char *set, int in_set)
+{
+	return ((in_set) ? strspn(s, set) : strcspn(s, set));
+}
+
+/**
+ * run - calls a primitive once on a string
+ * @impl: the set of primitives
+ * @primitive: the index of the primitive in primitives[]
+ * @a: a string of lowercase letters
+ * @b: a copy of @a
+ * @len: the length of @a
+ *
+ * Description: Every call processes the whole string: the character looked
+ * for isn't in it, and it is made only of bytes of the strspn() set.
+ *
+ * Return: a value that depends on the result, so the call isn't optimized out
+ */
+static size_t run(const string_impl_t *impl, int primitive, const char *a,
+		char *b, size_t len)
+{
+	switch (primitive)
+	{
+	case 0:
+		return (impl->strlen_fn(a));
+	case 1:
+		return (impl->strchr_fn(a, '$') == NULL);
+	case 2:
+		return (impl->strcmp_fn(a, b));
+	case 3:
+		return ((size_t)impl->memcpy_fn(b, a, len));
+	case 4:
+		return (impl->span_fn(a, "abcdefgh", 1));
+	default:
+		return (impl->span_fn(a, "'\"\\$", 0));
+	}
+}
+
+/**
+ * measure - measures the throughput of a primitive on strings of a length
+ * @impl: the set of primitives
+ * @primitive: the index of the primitive in primitives[]
+ * @a: a string of lowercase letters, at least @len bytes long
+ * @b: a copy of @a
+ * @len: the length of the strings to use
+ *
+ * Return: the throughput, in GB/s
+ */
+static double measure(const string_impl_t *impl, int primitive, char *a,
+		char *b, size_t len)
+{
+	size_t i, calls = BYTES_PER_RUN / len;
+	volatile size_t sink = 0;
+	struct timespec start, end;
+	char saved_a = a[len], saved_b = b[len];
+
+	a[len] = b[len] = '\0';
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for (i = 0; i < calls; i++)
+		sink += run(impl, primitive, a, b, len);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	a[len] = saved_a;
+	b[len] = saved_b;
+
+	return ((double)calls * len / ((end.tv_sec - start.tv_sec) * 1e9 +
+				(end.tv_nsec - start.tv_nsec)));
+}
+
+/**
+ * main - measures the throughput of every version of the string primitives
+ * the CPU supports, along with the C library's, from 8 B to 64 KiB strings
+ *
+ * Return: 0 on success, else 1
+ */
+int main(void)
+{
+	string_impl_t impls[] = {
+		{"scalar", strlen_scalar, strchr_scalar, strcmp_scalar, memcpy_scalar,
+			span_scalar},
+#ifdef MSH_X86
+		{"sse2", strlen_sse2, strchr_sse2, strcmp_sse2, memcpy_sse2, span_sse2},
+		{"avx2", strlen_avx2, strchr_avx2, strcmp_sse2, memcpy_avx2, span_avx2},
+#endif
+		{"libc", strlen, strchr, strcmp, memcpy, span_libc}
+	};
+	size_t n = sizeof(impls) / sizeof(impls[0]), i, j;
+	char *a = malloc(MAX_LEN + 128), *b = malloc(MAX_LEN + 128);
+	int primitive;
+
+	if (a == NULL || b == NULL)
+		return (1);
+	a += 64 - (size_t)a % 64 + ALIGNMENT;
+	b += 64 - (size_t)b % 64 + ALIGNMENT;
+	for (i = 0; i < MAX_LEN; i++)
+		a[i] = b[i] = 'a' + i % 8;
+
+	printf("%-8s %-7s", "GB/s", "impl");
+	for (j = 0; j < 5; j++)
+		printf(" %9lu B", lengths[j]);
+	printf("\n");
+	for (primitive = 0; primitive < 6; primitive++)
+		for (i = 0; i < n; i++)
+		{
+#ifdef MSH_X86
+			if (!_strcmp(impls[i].name, "avx2") &&
+					!__builtin_cpu_supports("avx2"))
+				continue;
+#endif
+			printf("%-8s %-7s", primitives[primitive], impls[i].name);
+			for (j = 0; j < 5; j++)
+				printf(" %11.2f", measure(&impls[i], primitive, a, b,
+							lengths[j]));
+			printf("\n");
+		}
+
+	return (0);
+}
@@ -0,0 +1,169 @@
+#include "bench.h"
+
+const char *workload_names[WORKLOADS] = {
+	"empty", "external", "builtin", "alias", "define", "variable", "chain",
+	"test", "large"
+};
+
+/**
+ * write_script - writes the script of a workload to a file
+ * @path: the path of the file
+ * @shell: the shell the script is written for
+ * @workload: the workload (one of the workload enum)
+ * @marks: see write_workload()
+ *
+ * Return: the number of commands in the script, else -1 if it couldn't be
+ * written
+ */
+long write_script(const char *path, const shell_spec_t *shell, int workload,
+		size_t *marks)
+{
+	FILE *file = fopen(path, "w");
+	long commands;
+
+	if (file == NULL)
+		return (-1);
+	commands = write_workload(file, shell, workload, marks);
+
+	return ((fclose(file) == 0) ? commands : -1);
+}
+
+/**
+ * write_workload - writes the script of a workload for a shell
+ * @script: the script file
+ * @shell: the shell the script is written for
+ * @workload: the workload (one of the workload enum)
+ * @marks: NULL for the plain script, else where to store the number of
+ * BENCH_MARK lines written: one after the setup and one after every line
+ * with commands, see run_timed()
+ *
+ * Description: The timed version of the empty workload is made of
+ * BENCH_COMMANDS marks alone, which measures what a mark costs.
+ *
+ * Return: the number of commands in the script
+ */
+size_t write_workload(FILE *script, const shell_spec_t *shell, int workload,
+		size_t *marks)
+{
+	size_t i, lines = BENCH_COMMANDS, commands = 0, n;
+
+	write_setup(script, shell, workload);
+	if (workload == EMPTY && marks == NULL)
+		return (0);
+	if (workload == CHAIN)
+		lines = BENCH_COMMANDS / 100; /* lines of 100 commands */
+	else if (workload == TEST || workload == LARGE)
+		lines = BENCH_LARGE;
+
+	if (marks != NULL)
+	{
+		fputs(BENCH_MARK, script);
+		*marks = 1;
+	}
+	for (i = 0; i < lines; i++)
+	{
+		n = (workload == EMPTY) ? 0 : write_line(script, i, workload);
+		commands += n;
+		if (marks != NULL && (n > 0 || workload == EMPTY))
+		{
+			fputs(BENCH_MARK, script);
+			(*marks)++;
+		}
+	}
+
+	return (commands);
+}
+
+/**
+ * write_setup - writes the lines defining what a workload needs
+ * @script: the script file
+ * @shell: the shell the script is written for
+ * @workload: the workload (one of the workload enum)
+ *
+ * Description: Aliases come in chains of ten, the first alias of a chain
+ * stands for `cd` and every other one for the previous alias, so using the
+ * last alias of a chain takes ten expansions.
+ */
+void write_setup(FILE *script, const shell_spec_t *shell, int workload)
+{
+	size_t i;
+	char name[32], value[32];
+
+	if (shell->prelude != NULL)
+		fprintf(script, "%s\n", shell->prelude);
+
+	for (i = 0; (workload == ALIAS || workload == LARGE) &&
+			i < BENCH_ALIASES; i++)
+	{
+		if (i % 10 == 0)
+			fprintf(script, "alias al%lu='cd'\n", (unsigned long)i);
+		else
+			fprintf(script, "alias al%lu='al%lu'\n", (unsigned long)i,
+					(unsigned long)i - 1);
+	}
+
+	for (i = 0; (workload == VARIABLE || workload == LARGE) &&
+			i < BENCH_VARIABLES; i++)
+	{
+		sprintf(name, "V%lu", (unsigned long)i);
+		sprintf(value, "/");
+		fprintf(script, shell->setenv, name, value);
+		fprintf(script, "\n");
+	}
+	if (workload == TEST)
+	{
+		fprintf(script, shell->setenv, "x", "1");
+		fprintf(script, "\n");
+	}
+}
+
+/**
+ * write_line - writes a line of the script of a workload
+ * @script: the script file
+ * @i: the number of the line, from 0
+ * @workload: the workload (one of the workload enum)
+ *
+ * Description: The large script mixes comments, blank lines and the lines
+ * of the builtin, alias and variable workloads.
+ *
+ * Return: the number of commands on the line
+ */
+size_t write_line(FILE *script, size_t i, int workload)
+{
+	unsigned long n = i % 100;
+
+	if (workload == LARGE && i % 8 == 0)
+		fprintf(script, "# comment %lu\n", n);
+	else if (workload == LARGE && i % 8 == 1)
+		fprintf(script, "\n");
+	if (workload == LARGE)
+		return ((i % 8 < 2) ? 0 : write_line(script, i,
+					(i % 3 == 0) ? BUILTIN : (i % 3 == 1) ? ALIAS : VARIABLE));
+
+	switch (workload)
+	{
+	case EXTERNAL:
+		fprintf(script, "/bin/true\n");
+		return (1);
+	case BUILTIN:
+		fprintf(script, "cd /\n");
+		return (1);
+	case ALIAS:
+		fprintf(script, "al%lu /\n", (n / 10) * 10 + 9);
+		return (1);
+	case DEFINE:
+		fprintf(script, "alias def%lu='cd \"/\"'\n", (unsigned long)i);
+		return (1);
+	case VARIABLE:
+		fprintf(script, "cd $V%lu\n", n);
+		return (1);
+	case TEST:
+		fprintf(script, "[ -n \"$x\" ] && echo ok\n");
+		return (2);
+	default:
+		for (n = 0; n < 99; n++)
+			fprintf(script, "cd / %s ", (n % 2) ? "||" : "&&");
+		fprintf(script, "cd /\n");
+		return (100);
+	}
+}
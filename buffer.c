@@ -0,0 +1,86 @@
+#include "shell.h"
+
+/**
+ * buffer_reserve - makes room in a buffer
+ * @buf: the buffer
+ * @extra: the number of bytes that will be written to the buffer
+ *
+ * Description: The buffer at least doubles when it grows, so writing to it
+ * byte by byte costs amortized constant time.
+ *
+ * Return: 0 on success, else -1 if memory allocation failed
+ */
+int buffer_reserve(buffer_t *buf, size_t extra)
+{
+	size_t size = (buf->size == 0) ? 256 : buf->size;
+	char *data;
+
+	if (buf->len + extra <= buf->size)
+		return (0);
+
+	while (size < buf->len + extra)
+		size *= 2;
+	data = _realloc(buf->data, buf->size, size);
+	if (data == NULL)
+		return (-1);
+	buf->data = data;
+	buf->size = size;
+
+	return (0);
+}
+
+/**
+ * buffer_write - appends bytes to a buffer
+ * @buf: the buffer
+ * @str: the bytes
+ * @len: the number of bytes
+ *
+ * Return: 0 on success, else -1 if memory allocation failed
+ */
+int buffer_write(buffer_t *buf, const char *str, size_t len)
+{
+	if (buffer_reserve(buf, len) == -1)
+		return (-1);
+
+	_memcpy(buf->data + buf->len, str, len);
+	buf->len += len;
+
+	return (0);
+}
+
+/**
+ * buffer_putc - appends a byte to a buffer
+ * @buf: the buffer
+ * @c: the byte
+ *
+ * Return: 0 on success, else -1 if memory allocation failed
+ */
+int buffer_putc(buffer_t *buf, char c)
+{
+	if (buf->len == buf->size && buffer_reserve(buf, 1) == -1)
+		return (-1);
+
+	buf->data[buf->len++] = c;
+
+	return (0);
+}
+
+/**
+ * buffer_trim - empties a buffer, giving its memory back if it grew past
+ * LINE_MEMORY_MAX
+ * @buf: the buffer
+ *
+ * Description: The expansion buffers are reused from one line to the next,
+ * but one huge line, e.g. a long $(...) output, mustn't pin that much memory
+ * for the rest of the session.
+ */
+void buffer_trim(buffer_t *buf)
+{
+	buf->len = 0;
+	if (buf->size <= LINE_MEMORY_MAX)
+		return;
+
+	safe_free(buf->data);
+	buf->size = 0;
+	malloc_trim(0); /* the C library would keep it otherwise */
+}
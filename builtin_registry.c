@@ -0,0 +1,175 @@
+#include "shell.h"
+
+/**
+ * run_exit - runs the exit builtin
+ * @msh: contains all the data relevant to the shell's operation
+ *
+ * Return: the exit code, if the shell didn't exit
+ */
+static int run_exit(shell_t *msh)
+{
+	return (handle_exit(msh, multi_free));
+}
+
+/**
+ * run_alias - runs the alias and unalias builtins
+ * @msh: contains all the data relevant to the shell's operation
+ *
+ * Description: The builtins parse the command as written, which is only
+ * kept when the command starts with their name. When the name came from an
+ * alias instead, the words of the command are joined back together.
+ *
+ * Return: the exit code of the builtin
+ */
+static int run_alias(shell_t *msh)
+{
+	char **words = msh->sub_command, *text = msh->cmd_text, *end;
+	size_t i, len = 0;
+
+	if (text == NULL)
+	{
+		for (i = 0; words[i] != NULL; i++)
+			len += _strlen(words[i]) + 1;
+		text = arena_alloc(&msh->arena, len);
+		if (text == NULL)
+			return (1);
+		for (i = 0, end = text; words[i] != NULL; i++, end += len + 1)
+		{
+			len = _strlen(words[i]);
+			_memcpy(end, words[i], len);
+			end[len] = ' ';
+		}
+		end[-1] = '\0';
+	}
+
+	return (handle_alias(&msh->aliases, text));
+}
+
+/* the builtins, `slots` maps the hash of a name to its entry */
+static const builtin_t builtins[] = {
+	{"env", _printenv, BUILTIN_PIPELINE | BUILTIN_BARE},
+	{"printenv", _printenv, BUILTIN_PIPELINE},
+	{"exit", run_exit, BUILTIN_PIPELINE},
+	{"cd", handle_cd, BUILTIN_PIPELINE},
+	{"setenv", handle_setenv, BUILTIN_PIPELINE},
+	{"unsetenv", handle_setenv, BUILTIN_PIPELINE},
+	{"hash", handle_hash, BUILTIN_PIPELINE},
+	{"alias", run_alias, BUILTIN_PIPELINE | BUILTIN_SOURCE},
+	{"unalias", run_alias, BUILTIN_PIPELINE | BUILTIN_SOURCE},
+	{"jobs", handle_jobs, BUILTIN_PIPELINE},
+	{"wait", handle_wait, BUILTIN_PIPELINE},
+	{"fg", handle_fg_bg, 0},
+	{"bg", handle_fg_bg, 0},
+	{"echo", handle_echo, BUILTIN_PIPELINE | BUILTIN_CAPTURE},
+	{"printf", handle_printf, BUILTIN_PIPELINE | BUILTIN_CAPTURE},
+	{"test", handle_test, BUILTIN_PIPELINE | BUILTIN_CAPTURE},
+	{"[", handle_test, BUILTIN_PIPELINE | BUILTIN_CAPTURE},
+	{"true", handle_true, BUILTIN_PIPELINE | BUILTIN_CAPTURE},
+	{"false", handle_false, BUILTIN_PIPELINE | BUILTIN_CAPTURE},
+	{"parallel", handle_parallel, BUILTIN_PIPELINE}
+};
+
+/*
+ * A perfect hash of the names above: twice the first character, plus the last
+ * character, plus the length, modulo BUILTIN_SLOTS. `make` checks the table
+ * below against the names before linking the shell, and prints the right one
+ * when a builtin is added, see main(); a name that shares a slot with another
+ * one needs another multiplier, or more slots.
+ */
+#define HASH_NAME(name, len) ((2 * (unsigned char)(name)[0] + \
+		(unsigned char)(name)[(len) - 1] + (len)) & (BUILTIN_SLOTS - 1))
+
+/* the index of the builtin of each slot in `builtins`, plus one, 0 if free */
+static const unsigned char slots[BUILTIN_SLOTS] = {
+	0, 0, 3, 1, 0, 0, 0, 0, 0, 0, 0, 10, 15, 0, 0, 0,
+	0, 18, 17, 0, 20, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0,
+	16, 0, 5, 0, 9, 0, 11, 0, 6, 0, 0, 0, 4, 13, 0, 0,
+	0, 0, 0, 0, 0, 12, 19, 0, 0, 0, 8, 0, 7, 14, 0, 0
+};
+
+/**
+ * find_builtin - looks up a builtin by name
+ * @name: the name, it doesn't need to be NUL-terminated
+ * @len: the length of the name
+ *
+ * Description: The name is hashed to the only slot it can be in, and
+ * compared with the builtin found there, if any.
+ *
+ * Return: the builtin, else NULL if @name isn't one
+ */
+const builtin_t *find_builtin(const char *name, size_t len)
+{
+	const builtin_t *builtin;
+	size_t slot;
+
+	if (len == 0)
+		return (NULL);
+
+	slot = HASH_NAME(name, len);
+	if (slots[slot] == 0)
+		return (NULL);
+
+	builtin = &builtins[slots[slot] - 1];
+	if (_strncmp(builtin->name, name, len) || builtin->name[len] != '\0')
+		return (NULL);
+
+	return (builtin);
+}
+
+/**
+ * get_builtin - finds the builtin that runs a command
+ * @words: the words of the command
+ *
+ * Return: the builtin, else NULL if the command isn't run by one
+ */
+const builtin_t *get_builtin(char **words)
+{
+	const builtin_t *builtin = find_builtin(words[0], _strlen(words[0]));
+
+	if (builtin != NULL && (builtin->flags & BUILTIN_BARE) && words[1] != NULL)
+		return (NULL); /* left to the external program of the same name */
+
+	return (builtin);
+}
+
+#ifdef BUILTIN_CHECK
+/**
+ * main - checks the slots of the builtins, built and run by `make` before
+ * the shell is linked
+ *
+ * Description: On a mismatch, the table the names call for is printed, to
+ * be pasted in place of `slots`. Names sharing a slot are printed instead.
+ *
+ * Return: 0 if `slots` is right, else 1
+ */
+int main(void)
+{
+	size_t count = sizeof(builtins) / sizeof(builtins[0]), i, slot;
+	unsigned char expected[BUILTIN_SLOTS] = {0};
+	int wrong = 0;
+
+	init_string_ops();
+	for (i = 0; i < count; i++)
+	{
+		slot = HASH_NAME(builtins[i].name, _strlen(builtins[i].name));
+		if (expected[slot] != 0)
+		{
+			fprintf(stderr, "builtins: %s and %s share slot %lu\n",
+					builtins[expected[slot] - 1].name, builtins[i].name, slot);
+			return (1);
+		}
+		expected[slot] = i + 1;
+	}
+	for (slot = 0; slot < BUILTIN_SLOTS; slot++)
+		wrong |= (slots[slot] != expected[slot]);
+	if (!wrong)
+		return (0);
+
+	fprintf(stderr, "builtins: `slots` doesn't match the names, it must be:\n");
+	for (slot = 0; slot < BUILTIN_SLOTS; slot++)
+		fprintf(stderr, "%s%d%s", (slot % 16) ? " " : "\t", expected[slot],
+				(slot % 16 == 15) ? ",\n" : ",");
+
+	return (1);
+}
+#endif
@@ -2,98 +2,90 @@
 
 /**
  * _setenv - set a custom environment variable
+ * @msh: contains all the data relevant to the shell's operation
  * @name: the name of the variable
  * @value: the value to set
  * @overwrite: if true, overwrite the variable if it exists
  *
  * Description: This function sets a custom environment variable with the given
  * name and value. If the variable already exists and overwrite is true, it
- * will be replaced.
+ * will be replaced, keeping its place in the environment. Setting PATH
+ * rebuilds the list of PATH directories, see refresh_path().
  *
  * Return: 0 on success, 1 on error
  */
-int _setenv(const char *name, const char *value, int overwrite)
+int _setenv(shell_t *msh, const char *name, const char *value,
+		int overwrite)
 {
-	size_t len, i;
+	size_t name_len;
 	char *env_var = NULL;
+	var_t *var;
 
 	if (name == NULL || name[0] == '\0' || _strchr(name, '=') != NULL)
 	{
+		fflush(stdout); /* keep the output in order */
 		fprintf(stderr, "Invalid variable name: %s\n", name);
 		return (1);
 	}
 	/* check if the variable already exists */
-	if (_getenv(name) != NULL)
-	{
-		if (overwrite)
-		{
-			if (_unsetenv(name) != 0)
-				return (1);
-		}
-		else
-			return (0); /* variable exists, and overwrite is false */
-	}
-	len = _strlen(name) + _strlen(value) + 2;
-	env_var = malloc(len);
+	name_len = _strlen(name);
+	var = find_var(name, name_len);
+	if (var != NULL && !overwrite)
+		return (0); /* variable exists, and overwrite is false */
+
+	env_var = malloc(name_len + _strlen(value) + 2);
 	if (env_var == NULL)
 		return (1);
+	sprintf(env_var, "%s=%s", name, (value) ? value : "");
 
-	sprintf(env_var, "%s=%s", name, value);
-	for (i = 0; environ[i] != NULL; i++)
+	if (var != NULL)
 	{
-		if (_strncmp(environ[i], name, len) == 0 && environ[i][len] == '=')
-		{
-			environ[i] = env_var;
-			safe_free(env_var);
-			return (0);
-		}
+		retire_entry(var->entry);
+		var->entry = env_var;
+		mark_env_changed();
 	}
-	/* the variable doesn't exist, create it */
-	environ[i++] = env_var;
-	environ[i] = NULL;
-	safe_free(env_var);
+	else if (add_var(env_var, name_len) == NULL)
+		return (safe_free(env_var), 1); /* the variable couldn't be created */
+	if (!_strcmp(name, "PATH"))
+		refresh_path(msh);
 
 	return (0);
 }
 
 /**
  * _unsetenv - unset a custom environment variable
+ * @msh: contains all the data relevant to the shell's operation
  * @name: The name of the variable to unset
  *
  * Description: This function unsets a custom environment variable with the
- * given name.
+ * given name. Unsetting PATH empties the list of PATH directories.
  *
  * Return: 0 on success, 1 on error
  */
-int _unsetenv(const char *name)
+int _unsetenv(shell_t *msh, const char *name)
 {
-	size_t i, j, len;
+	var_t *var;
 
 	/* check for invalid variable names */
 	if (name == NULL || name[0] == '\0' || _strchr(name, '=') != NULL)
 	{
+		fflush(stdout); /* keep the output in order */
 		fprintf(stderr, "Invalid variable name: %s\n", name);
 		return (1);
 	}
 
-	len = _strlen(name);
-
-	/* iterate through the environment variables and find the one to remove */
-	for (i = 0; environ[i] != NULL; i++)
+	var = find_var(name, _strlen(name));
+	if (var == NULL)
 	{
-		if (_strncmp(environ[i], name, len) == 0 && environ[i][len] == '=')
-		{
-			/* shift all environment variables after the one to be removed */
-			for (j = i; environ[j] != NULL; j++)
-			{
-				environ[j] = environ[j + 1];
-			}
-			return (0);
-		}
+		fflush(stdout); /* keep the output in order */
+		dprintf(STDERR_FILENO, "Variable not found: %s\n", name);
+		return (1);
 	}
 
-	dprintf(STDERR_FILENO, "Variable not found: %s\n", name);
-	return (1);
+	delete_var(var);
+	if (!_strcmp(name, "PATH"))
+		refresh_path(msh);
+	return (0);
 }
 
 /**
@@ -110,22 +102,37 @@ int handle_exit(shell_t *msh, void (*cleanup)(const char *format, ...))
 
 	if (status_code == NULL)
 	{
-		cleanup("spattt", msh->line, &msh->path_list, &msh->aliases,
-				&msh->commands, &msh->sub_command, &msh->tokens);
+		hash_reset(msh);
+		free_jobs(msh);
+		free_env();
+		finish_cache(msh);
+		free_readers();
+		free_prompt();
+		free_arena(&msh->arena);
+		free_lexer(&msh->lexer);
+		cleanup("ssspa", msh->line, msh->expansion.data, msh->target.data,
+				&msh->path_list, &msh->aliases);
 		safe_free(msh);
 		exit(exit_code);
 	}
 
 	if (isalpha(*status_code) || _atoi(status_code) < 0 || *status_code == '-')
 	{
-		dprintf(STDERR_FILENO, "%s: %lu: exit: Illegal number: %s\n",
-				msh->prog_name, msh->cmd_count, status_code);
+		print_error(msh, "exit: Illegal number: %s\n", status_code);
 		return (CMD_ERR);
 	}
 
 	exit_code = _atoi(status_code);
-	cleanup("spattt", msh->line, &msh->path_list, &msh->aliases,
-			&msh->commands, &msh->sub_command, &msh->tokens);
+	hash_reset(msh);
+	free_jobs(msh);
+	free_env();
+	finish_cache(msh);
+	free_readers();
+	free_prompt();
+	free_arena(&msh->arena);
+	free_lexer(&msh->lexer);
+	cleanup("ssspa", msh->line, msh->expansion.data, msh->target.data,
+			&msh->path_list, &msh->aliases);
 	safe_free(msh);
 	exit(exit_code);
 }
@@ -155,18 +162,16 @@ int handle_cd(shell_t *msh)
 		if (chdir(path) == -1)
 		{
 			if (_strspn(pathname, "-") > 2)
-				fprintf(stderr, "%s: %lu: cd: Illegal option: --\n", msh->prog_name,
-						msh->cmd_count);
+				print_error(msh, "cd: Illegal option: --\n");
 			else
-				fprintf(stderr, "%s: %lu: cd: can't cd to %s\n", msh->prog_name,
-						msh->cmd_count, pathname);
+				print_error(msh, "cd: can't cd to %s\n", pathname);
 			return (CMD_ERR);
 		}
 		if (dash)
 			printf("%s\n", oldpath);
-		setenv("OLDPWD", pwd, 1);
+		_setenv(msh, "OLDPWD", pwd, 1);
 		getcwd(path, PATH_SIZE);
-		setenv("PWD", path, 1);
+		_setenv(msh, "PWD", path, 1);
 	}
 	else
 	{
@@ -174,39 +179,52 @@ int handle_cd(shell_t *msh)
 			return (0); /* HOME is not set */
 		if (chdir(home) == -1)
 			return (CMD_ERR);
-		setenv("OLDPWD", pwd, 1);
-		setenv("PWD", home, 1);
+		_setenv(msh, "OLDPWD", pwd, 1);
+		_setenv(msh, "PWD", home, 1);
 	}
 	return (0);
 }
 
 /**
- * _printenv - prints all environment variables
+ * _printenv - handles the builtin `env` and `printenv` commands
+ * @msh: contains all the data relevant to the shell's operation
+ *
+ * Description: With no arguments, all the environment variables are printed.
+ * `printenv NAME...` prints the value of each variable given instead. The
+ * output is written directly from the environment, without leaving the
+ * shell. `env` with arguments runs a command, get_builtin() leaves that to
+ * the external `env` program.
+ *
+ * Return: 0 on success, else 1 if a variable was not found or writing failed
  */
-void _printenv(void)
+int _printenv(shell_t *msh)
 {
-	int fd, status;
-	char *filename = "/tmp/env";
-	pid_t child;
+	size_t i, count = 0;
+	char **values;
+	int exit_code = 0;
 
-	fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
-	if (fd == -1)
-		return;
+	if (msh->sub_command[1] == NULL)
+		return (write_lines(STDOUT_FILENO, get_envp()) == -1);
 
-	if (write(fd, "env", 3) != -1)
-	{
-		char *argv[] = {"/bin/sh", "/tmp/env", NULL};
+	for (i = 1; msh->sub_command[i] != NULL; i++)
+		;
+	values = malloc(sizeof(char *) * i);
+	if (values == NULL)
+		return (1);
 
-		child = fork();
-		if (child == 0)
-			execve(argv[0], argv, environ);
-		else
-			waitpid(child, &status, 0);
-		close(fd);
-	}
-	else
+	for (i = 1; msh->sub_command[i] != NULL; i++)
 	{
-		close(fd);
-		return;
+		values[count] = _getenv(msh->sub_command[i]);
+		if (values[count] != NULL)
+			count++;
+		else
+			exit_code = 1;
 	}
+	values[count] = NULL;
+
+	if (write_lines(STDOUT_FILENO, values) == -1)
+		exit_code = 1;
+	safe_free(values);
+
+	return (exit_code);
 }
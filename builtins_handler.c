@@ -1,36 +1,88 @@
 #include "shell.h"
 
 /**
- * handle_builtin - handles the builtin commands
+ * handle_builtin - runs a builtin command in the shell
  * @msh: contains all the data relevant to the shell's operation
+ * @builtin: the builtin, see get_builtin()
+ * @node: the node of the command
  *
- * Return: exit code
+ * Description: The redirections of the command are applied to the shell for
+ * as long as the builtin runs.
+ *
+ * Return: the exit code of the builtin
  */
-int handle_builtin(shell_t *msh)
+int handle_builtin(shell_t *msh, const builtin_t *builtin, node_t *node)
 {
-	if (!_strcmp(msh->sub_command[0], "env") ||
-		!_strcmp(msh->sub_command[0], "printenv"))
+	size_t count = msh->redirect.count;
+	int exit_code = CMD_ERR, *saved = NULL;
+
+	if (count > 0)
+		saved = arena_alloc(&msh->arena, sizeof(int) * count);
+	if (count == 0 || (saved != NULL && apply_redirs(msh, saved) == 0))
 	{
-		_printenv();
-		return (0);
+		msh->cmd_text = node->text;
+		exit_code = builtin->run(msh);
+		msh->cmd_text = NULL;
 	}
-	else if (!_strcmp(msh->sub_command[0], "exit"))
+	if (saved != NULL)
+		restore_redirs(msh, saved);
+
+	return (exit_code);
+}
+
+/**
+ * restore_fds - restores the file descriptors saved by apply_redirs(), the
+ * last redirection first
+ * @redir: the redirection to restore, along with the ones after it
+ * @saved: the saved copy of its file descriptor, followed by the others
+ * @count: the number of redirections left to restore
+ */
+static void restore_fds(redir_t *redir, int *saved, size_t count)
+{
+	if (count == 0)
+		return;
+
+	restore_fds(redir->next, saved + 1, count - 1);
+	if (*saved == -1)
+		close(redir->fd);
+	else if (*saved >= 0)
 	{
-		return (handle_exit(msh, multi_free));
+		dup2(*saved, redir->fd);
+		close(*saved);
 	}
+}
 
-	/* let's handle the builtin 'cd' command */
-	else if (!_strcmp(msh->sub_command[0], "cd"))
-		return (handle_cd(msh));
+/**
+ * restore_redirs - undoes the redirections applied to the shell by
+ * apply_redirs()
+ * @msh: contains all the data relevant to the shell's operation
+ * @saved: the file descriptors saved by apply_redirs()
+ */
+void restore_redirs(shell_t *msh, int *saved)
+{
+	fflush(stdout); /* the builtin's output goes where it was redirected */
+	restore_fds(msh->redirect.redirs, saved, msh->redirect.count);
+}
+
+/**
+ * handle_setenv - handles the builtin `setenv` and `unsetenv` commands
+ * @msh: contains all the data relevant to the shell's operation
+ *
+ * Return: 0 on success, else 1 on error
+ */
+int handle_setenv(shell_t *msh)
+{
+	int exit_code;
+	const char *name = msh->sub_command[1];
 
-	else if (!_strcmp(msh->sub_command[0], "setenv"))
+	if (!_strcmp(msh->sub_command[0], "setenv"))
 	{
-		if (msh->sub_command[1] && msh->sub_command[2])
-			return (setenv(msh->sub_command[1], msh->sub_command[2], 1));
-		return (1); /* invalid number of parameters received */
+		if (name == NULL || msh->sub_command[2] == NULL)
+			return (1); /* invalid number of parameters received */
+		exit_code = _setenv(msh, name, msh->sub_command[2], 1);
 	}
-	else if (!_strcmp(msh->sub_command[0], "unsetenv"))
-		return (_unsetenv(msh->sub_command[1]));
+	else
+		exit_code = _unsetenv(msh, name);
 
-	return (NOT_BUILTIN); /* not a builtin command */
+	return (exit_code);
 }
@@ -0,0 +1,98 @@
+#include "shell.h"
+
+/**
+ * resize_block - replaces the buffer of a cache with one of another size,
+ * without keeping its content
+ * @cache: the cache
+ * @size: the size of the new buffer
+ *
+ * Description: A buffer that grew past LINE_MEMORY_MAX for a huge line is
+ * handed back to the system rather than kept for the next blocks.
+ *
+ * Return: 0 on success, else -1 if memory allocation failed, leaving the
+ * buffer as it was
+ */
+static int resize_block(script_cache_t *cache, size_t size)
+{
+	char *buffer = malloc(size);
+
+	if (buffer == NULL)
+		return (-1);
+
+	safe_free(cache->buffer);
+	if (cache->size > LINE_MEMORY_MAX)
+		malloc_trim(0); /* the C library would keep it otherwise */
+	cache->buffer = buffer;
+	cache->size = size;
+
+	return (0);
+}
+
+/**
+ * put_block - writes the lines waiting in the buffer of the cache being
+ * written, as a block
+ * @cache: the cache
+ *
+ * Description: Every block carries the checksum of its own bytes, so a bad
+ * block is found before any of its lines run, see get_block().
+ */
+void put_block(script_cache_t *cache)
+{
+	cache_block_t block;
+	struct iovec iov[2];
+
+	if (cache->failed || cache->len == 0)
+		return;
+
+	block.length = cache->len;
+	block.checksum = hash_bytes(cache->buffer, cache->len);
+	iov[0].iov_base = &block;
+	iov[0].iov_len = sizeof(cache_block_t);
+	iov[1].iov_base = cache->buffer;
+	iov[1].iov_len = cache->len;
+	cache->failed = (writev_all(cache->fd, iov, 2) == -1);
+	cache->header.length += sizeof(cache_block_t) + cache->len;
+	cache->len = 0;
+	if (cache->size > LINE_MEMORY_MAX)
+		resize_block(cache, READ_SIZE);
+}
+
+/**
+ * get_block - loads the next block of a cache being loaded, in place of the
+ * previous one
+ * @cache: the cache
+ *
+ * Description: The buffer of the cache only grows for blocks holding a line
+ * larger than READ_SIZE, and shrinks back past LINE_MEMORY_MAX, so memory
+ * use doesn't depend on the size of the script.
+ *
+ * Return: 1 if a block was loaded, 0 at the end of the cache, else -1 if the
+ * rest of the cache can't be used: it is short, a checksum doesn't match or
+ * memory allocation failed
+ */
+int get_block(script_cache_t *cache)
+{
+	cache_block_t block;
+
+	cache->len = cache->pos = 0;
+	if (cache->header.length == 0)
+		return (0);
+	if (cache->header.length < sizeof(cache_block_t) ||
+			read_full(cache->load_fd, &block,
+				sizeof(cache_block_t)) == -1 ||
+			block.length == 0 ||
+			block.length > cache->header.length - sizeof(cache_block_t))
+		return (-1);
+
+	if ((block.length > cache->size || cache->size > LINE_MEMORY_MAX) &&
+			resize_block(cache, (block.length > READ_SIZE) ?
+				block.length : READ_SIZE) == -1)
+		return (-1);
+	if (read_full(cache->load_fd, cache->buffer, block.length) == -1 ||
+			hash_bytes(cache->buffer, block.length) != block.checksum)
+		return (-1);
+	cache->header.length -= sizeof(cache_block_t) + block.length;
+	cache->len = block.length;
+
+	return (1);
+}
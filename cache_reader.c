@@ -0,0 +1,145 @@
+#include "shell.h"
+
+/**
+ * read_full - reads an exact number of bytes from a file descriptor
+ * @fd: the file descriptor
+ * @buffer: where to store the bytes
+ * @n: the number of bytes to read
+ *
+ * Return: 0 on success, else -1 on failure or if the input was too short
+ */
+int read_full(int fd, void *buffer, size_t n)
+{
+	char *bytes = buffer;
+	ssize_t n_read;
+
+	while (n > 0)
+	{
+		n_read = read(fd, bytes, n);
+		if (n_read == -1 && errno == EINTR)
+			continue;
+		if (n_read <= 0)
+			return (-1);
+		bytes += n_read;
+		n -= n_read;
+	}
+
+	return (0);
+}
+
+/**
+ * get_bytes - takes the next bytes out of a loaded cache
+ * @cache: the cache
+ * @dest: where to copy the bytes
+ * @n: the number of bytes
+ *
+ * Return: 0 on success, else -1 if the cache is too short
+ */
+int get_bytes(script_cache_t *cache, void *dest, size_t n)
+{
+	if (cache->failed || n > cache->len - cache->pos)
+	{
+		cache->failed = 1;
+		return (-1);
+	}
+
+	_memcpy(dest, cache->buffer + cache->pos, n);
+	cache->pos += n;
+
+	return (0);
+}
+
+/**
+ * get_number - takes the next number out of a loaded cache
+ * @cache: the cache
+ * @n: where to store the number
+ *
+ * Return: 0 on success, else -1 on failure
+ */
+int get_number(script_cache_t *cache, size_t *n)
+{
+	unsigned char byte = 0x80;
+	size_t shift;
+
+	*n = 0;
+	for (shift = 0; byte & 0x80; shift += 7)
+	{
+		if (shift >= sizeof(size_t) * 8 || get_bytes(cache, &byte, 1) == -1)
+			return (cache->failed = 1, -1);
+		*n |= (size_t)(byte & 0x7f) << shift;
+	}
+
+	return (0);
+}
+
+/**
+ * get_string - takes the next string out of a loaded cache
+ * @cache: the cache
+ * @arena: the arena to allocate the string from
+ *
+ * Return: the string, else NULL if it was stored as NULL or on failure, in
+ * which case the cache is marked as failed
+ */
+char *get_string(script_cache_t *cache, arena_t *arena)
+{
+	size_t len;
+	char *str;
+
+	if (get_number(cache, &len) == -1 || len == 0)
+		return (NULL);
+
+	if (len - 1 > cache->len - cache->pos || (str = arena_strndup(arena,
+					cache->buffer + cache->pos, len - 1)) == NULL)
+	{
+		cache->failed = 1;
+		return (NULL);
+	}
+	cache->pos += len - 1;
+
+	return (str);
+}
+
+/**
+ * get_node - takes the next command tree out of a loaded cache
+ * @cache: the cache
+ * @arena: the arena to allocate the tree from
+ *
+ * Description: The chain of right operands is read in a loop, the way
+ * put_node() writes it.
+ *
+ * Return: the root of the tree, else NULL if it was stored as NULL or on
+ * failure, in which case the cache is marked as failed
+ */
+node_t *get_node(script_cache_t *cache, arena_t *arena)
+{
+	size_t type, count, i;
+	node_t *tree = NULL, **tail = &tree, *node;
+
+	while (!cache->failed && get_number(cache, &type) == 0 && type != 0)
+	{
+		if (type > NODE_TIME || (node = new_node(arena, type, NULL, NULL)) ==
+				NULL)
+		{
+			cache->failed = 1;
+			break;
+		}
+		node->text = get_string(cache, arena);
+		if (get_number(cache, &count) == 0 && count > 0)
+		{
+			if (count > cache->len - cache->pos || (node->words =
+						arena_alloc(arena, sizeof(char *) * (count + 1))) == NULL)
+				cache->failed = 1;
+			for (i = 0; i < count && !cache->failed; i++)
+				if ((node->words[i] = get_string(cache, arena)) == NULL)
+					cache->failed = 1;
+			if (!cache->failed)
+				node->words[count] = NULL;
+		}
+		node->redirs = get_redirs(cache, arena);
+		node->left = get_node(cache, arena);
+		*tail = node;
+		tail = &node->right;
+	}
+
+	return ((cache->failed) ? NULL : tree);
+}
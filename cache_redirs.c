@@ -0,0 +1,56 @@
+#include "shell.h"
+
+/**
+ * put_redirs - adds the redirections of a simple command to the cache being
+ * written
+ * @cache: the cache
+ * @redir: the first redirection, can be NULL
+ *
+ * Description: Every redirection is stored as its type, file descriptor and
+ * target, here-documents along with their body, and a type of 0 ends the
+ * list.
+ */
+void put_redirs(script_cache_t *cache, redir_t *redir)
+{
+	for (; redir != NULL; redir = redir->next)
+	{
+		put_number(cache, redir->type);
+		put_number(cache, redir->fd);
+		put_string(cache, redir->target);
+	}
+	put_number(cache, 0);
+}
+
+/**
+ * get_redirs - takes the redirections of a simple command out of a loaded
+ * cache
+ * @cache: the cache
+ * @arena: the arena to allocate the redirections from
+ *
+ * Return: the first redirection, else NULL if there are none or on failure,
+ * in which case the cache is marked as failed
+ */
+redir_t *get_redirs(script_cache_t *cache, arena_t *arena)
+{
+	redir_t *redirs = NULL, **tail = &redirs;
+	size_t type, fd;
+
+	while (!cache->failed && get_number(cache, &type) == 0 && type != 0)
+	{
+		if (type > REDIR_DELIM_TABS || get_number(cache, &fd) == -1 ||
+				(*tail = arena_alloc(arena, sizeof(redir_t))) == NULL)
+		{
+			cache->failed = 1;
+			break;
+		}
+		(*tail)->type = type;
+		(*tail)->fd = fd;
+		(*tail)->target = get_string(cache, arena);
+		(*tail)->next = NULL;
+		if ((*tail)->target == NULL)
+			cache->failed = 1;
+		tail = &(*tail)->next;
+	}
+
+	return ((cache->failed) ? NULL : redirs);
+}
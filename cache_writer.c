@@ -0,0 +1,146 @@
+#include "shell.h"
+
+/**
+ * put_bytes - adds bytes to the cache being written
+ * @cache: the cache
+ * @data: the bytes to add
+ * @n: the number of bytes to add
+ *
+ * Description: The bytes wait in the buffer of the cache until a block of
+ * whole lines is written, see put_block(), so the buffer only grows past
+ * READ_SIZE for lines larger than that.
+ */
+void put_bytes(script_cache_t *cache, const void *data, size_t n)
+{
+	size_t size = cache->size;
+	char *buffer;
+
+	if (cache->failed)
+		return;
+
+	while (size - cache->len < n)
+		size *= 2;
+	if (size != cache->size)
+	{
+		buffer = _realloc(cache->buffer, cache->size, size);
+		if (buffer == NULL)
+		{
+			cache->failed = 1;
+			return;
+		}
+		cache->buffer = buffer;
+		cache->size = size;
+	}
+
+	_memcpy(cache->buffer + cache->len, data, n);
+	cache->len += n;
+}
+
+/**
+ * put_number - adds a number to the cache being written
+ * @cache: the cache
+ * @n: the number
+ *
+ * Description: Numbers are stored 7 bits at a time, with the high bit of
+ * each byte telling whether more bytes follow, so small numbers take a
+ * single byte.
+ */
+void put_number(script_cache_t *cache, size_t n)
+{
+	unsigned char bytes[sizeof(size_t) * 2];
+	size_t len = 0;
+
+	do {
+		bytes[len++] = (n & 0x7f) | ((n > 0x7f) ? 0x80 : 0);
+		n >>= 7;
+	} while (n > 0);
+
+	put_bytes(cache, bytes, len);
+}
+
+/**
+ * put_string - adds a string to the cache being written
+ * @cache: the cache
+ * @str: the string, can be NULL
+ */
+void put_string(script_cache_t *cache, const char *str)
+{
+	size_t len = (str == NULL) ? 0 : _strlen(str) + 1;
+
+	put_number(cache, len);
+	if (len > 1)
+		put_bytes(cache, str, len - 1);
+}
+
+/**
+ * put_node - adds a command tree to the cache being written
+ * @cache: the cache
+ * @node: the root of the tree, can be NULL
+ *
+ * Description: The right operands are written one after the other rather
+ * than recursively, since long command lists and and-or lists are chains of
+ * nodes on the right.
+ */
+void put_node(script_cache_t *cache, node_t *node)
+{
+	size_t count;
+
+	for (; node != NULL; node = node->right)
+	{
+		put_number(cache, node->type);
+		/* only jobs and the BUILTIN_SOURCE builtins keep their source text */
+		put_string(cache, node->text);
+		for (count = 0; node->words != NULL && node->words[count] != NULL;)
+			count++;
+		put_number(cache, count);
+		for (count = 0; node->words != NULL && node->words[count] != NULL;
+				count++)
+			put_string(cache, node->words[count]);
+		put_redirs(cache, node->redirs);
+
+		put_node(cache, node->left);
+	}
+	put_number(cache, 0);
+}
+
+/**
+ * finish_cache - completes the cache of the script being run, if any
+ * @msh: contains all the data relevant to the shell's operation
+ *
+ * Description: When the script exits early, the lines that didn't run are
+ * still compiled so that the cache covers the whole script. The cache is
+ * dropped if the script changed while it was running.
+ */
+void finish_cache(shell_t *msh)
+{
+	script_cache_t *cache = msh->cache;
+	size_t n = 0;
+	ssize_t n_read;
+
+	if (cache == NULL || cache->fd == -1)
+	{
+		free_cache(&msh->cache);
+		return;
+	}
+
+	while ((n_read = _getline(&msh->line, &n, cache->script_fd)) > 0)
+	{
+		++msh->cmd_count;
+		if (compile_line(msh) == -1)
+			n_read = -1;
+		msh->tree = NULL;
+		arena_reset(&msh->arena);
+		if (n_read == -1)
+			break;
+	}
+
+	put_block(cache);
+	if (n_read == 0 && !cache->failed &&
+			cache_matches(&cache->header, cache->script_fd) &&
+			pwrite(cache->fd, &cache->header, sizeof(cache_header_t), 0) ==
+			sizeof(cache_header_t) &&
+			rename(cache->temp_path, cache->path) == 0)
+		safe_free(cache->temp_path); /* it is the cache now, keep it */
+
+	free_cache(&msh->cache);
+}
@@ -5,46 +5,163 @@
  * @pathname: the absolute path to the binary file to execute
  * @msh: the shell's context
  *
- * Return: 0 on success, -1 on failure
+ * Description: The command gets the redirections in msh->redirect.
+ * Background commands are added to the job table instead of being waited on.
+ *
+ * Return: the exit code of the executed program, 126 if it could not be
+ * executed, else -1 on failure
  */
 int execute_command(const char *pathname, shell_t *msh)
 {
-	int status;
+	posix_spawn_file_actions_t actions;
+	int error;
 	pid_t pid;
 
-	pid = fork();
-	if (pid == -1)
+	fflush(stdout); /* don't let the child inherit our pending output */
+	msh->job_pgid = 0;
+	posix_spawn_file_actions_init(&actions);
+	add_redir_actions(msh, &actions);
+	error = spawn_command(msh, pathname, &actions, &pid);
+	posix_spawn_file_actions_destroy(&actions);
+	if (error != 0)
+		return (print_spawn_error(msh, error));
+
+	if (msh->async)
+		return (add_job(msh, pid, pid, 1));
+
+	return (wait_command(pid));
+}
+
+/**
+ * execute_tree - executes a command tree
+ * @msh: contains all the data relevant to the shell's operation
+ * @node: the root of the tree
+ *
+ * Return: the exit code of the last executed command
+ */
+int execute_tree(shell_t *msh, node_t *node)
+{
+	int run = 1;
+
+	while (node != NULL && node->type == NODE_SEQ)
 	{
-		perror("fork");
-		return (-1);
+		execute_tree(msh, node->left);
+		node = node->right;
 	}
 
-	if (pid == 0)
+	/* an and-or list, a pipeline only runs if the operator before it allows */
+	for (; node != NULL && (node->type == NODE_AND || node->type == NODE_OR);
+			node = node->right)
 	{
-		if (execve(pathname, msh->sub_command, environ) == -1)
-		{
-			if (errno == EACCES)
-			{
-				fprintf(stderr, "%s: %lu: %s\n", msh->prog_name,
-						++msh->cmd_count, strerror(errno));
-				return (126);
-			}
-			perror("execve");
-			return (-1);
-		}
+		if (run)
+			execute_tree(msh, node->left);
+		run = ((msh->exit_code == 0) == (node->type == NODE_AND));
 	}
-	else
+	if (node == NULL || !run)
+		return (msh->exit_code);
+
+	switch (node->type)
+	{
+	case NODE_ASYNC:
+		run_background(msh, node);
+		break;
+	case NODE_PIPE:
+		execute_pipeline(msh, node);
+		break;
+	case NODE_TIME:
+		time_command(msh, node->left);
+		break;
+	default:
+		run_simple(msh, node);
+	}
+
+	return (msh->exit_code);
+}
+
+/**
+ * run_simple - runs a simple command
+ * @msh: contains all the data relevant to the shell's operation
+ * @node: the node of the simple command
+ *
+ * Description: The words are expanded first, then the redirections are
+ * opened. A command made of redirections alone only opens them.
+ *
+ * Return: the exit code of the executed program
+ */
+int run_simple(shell_t *msh, node_t *node)
+{
+	redirect_t outer;
+
+	if (node->words == NULL && node->redirs == NULL)
+		return (msh->exit_code); /* probably just lots of tabs or spaces */
+
+	/* the words are expanded in a copy, the tree may run again */
+	msh->sub_command = copy_words(&msh->arena, node->words, NULL);
+	if (msh->sub_command == NULL)
 	{
-		if (waitpid(pid, &status, 0) == -1)
-		{
-			perror("wait");
-			return (-1);
-		}
-		if (WIFEXITED(status))
-		{
-			return (WEXITSTATUS(status));
-		}
+		print_error(msh, "Memory allocation failed\n");
+		return (msh->exit_code = 1);
 	}
 
-	return (0);
+	/* aliases are replaced before the words are expanded */
+	expand_alias(msh);
+	msh->sub_command = handle_variables(msh);
+	if (msh->sub_command != NULL &&
+			open_redirs(msh, node->redirs, &outer) == -1)
+		msh->exit_code = CMD_ERR;
+	else if (msh->sub_command != NULL)
+	{
+		if (msh->sub_command[0] != NULL)
+			parse_helper(msh, node);
+		else if (node->words == NULL)
+			msh->exit_code = 0;
+		close_redirs(msh, &outer);
+	}
+	msh->sub_command = NULL;
+
+	return (msh->exit_code);
+}
+
+/**
+ * parse_helper - performs extra parsing on behalf of the parse and execute
+ * function
+ * @msh: contains all the data relevant to the shell's operation
+ * @node: the node of the simple command
+ */
+void parse_helper(shell_t *msh, node_t *node)
+{
+	const builtin_t *builtin = get_builtin(msh->sub_command);
+	pid_t pid;
+
+	if (builtin != NULL && msh->async)
+	{
+		msh->job_pgid = 0;
+		pid = run_builtin_stage(msh, builtin, node, STDIN_FILENO,
+				STDOUT_FILENO);
+		msh->exit_code = (pid == -1) ? 1 : add_job(msh, pid, pid, 1);
+		return;
+	}
+	if (builtin != NULL)
+	{
+		msh->exit_code = handle_builtin(msh, builtin, node);
+		return;
+	}
+
+	/* handle the command with the PATH variable or as a path */
+	msh->exit_code = handle_with_path(msh);
+	if (msh->exit_code == -1)
+		msh->exit_code = print_cmd_not_found(msh);
+}
+
+/**
+ * print_cmd_not_found - prints the command not found error
+ * @msh: contains all the data relevant to the shell's operation
+ *
+ * Return: 127 command not found code, else 0
+ */
+int print_cmd_not_found(shell_t *msh)
+{
+	print_error(msh, "%s: not found\n", msh->sub_command[0]);
+
+	return (CMD_NOT_FOUND); /* command not found */
 }
@@ -0,0 +1,168 @@
+#include "shell.h"
+
+/**
+ * hash_lookup - looks up the remembered location of a command
+ * @msh: contains all the data relevant to the shell's operation
+ * @name: the name of the command
+ *
+ * Description: A remembered path that is no longer executable is dropped from
+ * the table so that the caller falls back to searching the PATH again.
+ *
+ * Return: the remembered path of the command, else NULL if not found
+ */
+char *hash_lookup(shell_t *msh, const char *name)
+{
+	cmd_hash_t *current, *prev = NULL;
+	size_t index = hash_string(name) % HASH_SIZE;
+
+	for (current = msh->cmd_table[index]; current != NULL;
+			prev = current, current = current->next)
+	{
+		if (_strcmp(current->name, name))
+			continue;
+
+		if (access(current->path, X_OK) == 0)
+		{
+			current->hits++;
+			return (current->path);
+		}
+
+		/* the command was moved or removed, forget about it */
+		if (prev == NULL)
+			msh->cmd_table[index] = current->next;
+		else
+			prev->next = current->next;
+		multi_free("ss", current->name, current->path);
+		safe_free(current);
+		break;
+	}
+
+	return (NULL);
+}
+
+/**
+ * hash_insert - remembers the location of a command
+ * @msh: contains all the data relevant to the shell's operation
+ * @name: the name of the command
+ * @path: the full path the command was resolved to
+ *
+ * Return: the address of the newly added node, or the address of the
+ * existing node if the command was already remembered, else NULL on failure
+ */
+cmd_hash_t *hash_insert(shell_t *msh, const char *name, const char *path)
+{
+	cmd_hash_t *node;
+	size_t index = hash_string(name) % HASH_SIZE;
+
+	for (node = msh->cmd_table[index]; node != NULL; node = node->next)
+	{
+		if (!_strcmp(node->name, name))
+			return (node);
+	}
+
+	node = malloc(sizeof(cmd_hash_t));
+	if (node == NULL)
+		return (NULL);
+
+	node->name = _strdup(name);
+	node->path = _strdup(path);
+	if (node->name == NULL || node->path == NULL)
+	{
+		multi_free("ss", node->name, node->path);
+		safe_free(node);
+		return (NULL);
+	}
+	node->hits = 0;
+	node->next = msh->cmd_table[index];
+	msh->cmd_table[index] = node;
+
+	return (node);
+}
+
+/**
+ * hash_reset - forgets all the remembered command locations
+ * @msh: contains all the data relevant to the shell's operation
+ */
+void hash_reset(shell_t *msh)
+{
+	size_t i;
+	cmd_hash_t *current;
+
+	for (i = 0; i < HASH_SIZE; i++)
+	{
+		while (msh->cmd_table[i] != NULL)
+		{
+			current = msh->cmd_table[i];
+			msh->cmd_table[i] = current->next;
+			multi_free("ss", current->name, current->path);
+			safe_free(current);
+		}
+	}
+}
+
+/**
+ * print_hash - prints the remembered command locations and their hit counts
+ * @msh: contains all the data relevant to the shell's operation
+ */
+void print_hash(shell_t *msh)
+{
+	size_t i, count = 0;
+	cmd_hash_t *current;
+
+	for (i = 0; i < HASH_SIZE; i++)
+	{
+		for (current = msh->cmd_table[i]; current != NULL;
+				current = current->next)
+		{
+			if (count++ == 0)
+				printf("hits\tcommand\n");
+			printf("%4lu\t%s\n", current->hits, current->path);
+		}
+	}
+
+	if (count == 0)
+		printf("hash: hash table empty\n");
+}
+
+/**
+ * handle_hash - handles the builtin `hash` command
+ * @msh: contains all the data relevant to the shell's operation
+ *
+ * Description: With no arguments, the remembered command locations are
+ * printed. The `-r` option forgets them all, and any other argument is
+ * searched in the PATH and remembered. Arguments containing a '/' are
+ * ignored since such commands never go through the PATH.
+ *
+ * Return: 0 on success, 1 if a command was not found, else 2 on error
+ */
+int handle_hash(shell_t *msh)
+{
+	size_t i;
+	int exit_code = 0;
+	char path[BUFF_SIZE];
+
+	if (msh->sub_command[1] == NULL)
+		return (print_hash(msh), 0);
+
+	for (i = 1; msh->sub_command[i] != NULL; i++)
+	{
+		if (!_strcmp(msh->sub_command[i], "-r"))
+			hash_reset(msh);
+		else if (*msh->sub_command[i] == '-')
+		{
+			print_error(msh, "hash: Illegal option %s\n", msh->sub_command[i]);
+			return (CMD_ERR);
+		}
+		else if (_strchr(msh->sub_command[i], '/') != NULL)
+			continue; /* paths are never looked up, nothing to remember */
+		else if (search_path(msh->path_list, msh->sub_command[i], path) == 0)
+			hash_insert(msh, msh->sub_command[i], path);
+		else
+		{
+			print_error(msh, "hash: %s: not found\n", msh->sub_command[i]);
+			exit_code = 1;
+		}
+	}
+
+	return (exit_code);
+}
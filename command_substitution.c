@@ -0,0 +1,148 @@
+#include "shell.h"
+
+/**
+ * capture_write - appends what a builtin writes to the buffer capturing it
+ * @cookie: the buffer
+ * @data: the bytes written
+ * @len: the number of bytes
+ *
+ * Return: @len on success, else 0 if memory allocation failed
+ */
+static ssize_t capture_write(void *cookie, const char *data, size_t len)
+{
+	return ((buffer_write(cookie, data, len) == -1) ? 0 : (ssize_t)len);
+}
+
+/**
+ * capture_builtin - runs a simple command with a BUILTIN_CAPTURE builtin,
+ * appending its output to msh->expansion
+ * @msh: contains all the data relevant to the shell's operation
+ * @node: the node of the command
+ *
+ * Description: stdout is swapped for a stream writing straight into the
+ * buffer, and the command is expanded into a buffer of its own, so the
+ * words of the command being expanded are left alone.
+ *
+ * Return: 0 on success, else -1 on failure
+ */
+static int capture_builtin(shell_t *msh, node_t *node)
+{
+	cookie_io_functions_t io = {NULL, capture_write, NULL, NULL};
+	buffer_t outer = msh->expansion;
+	char **words = msh->sub_command;
+	FILE *out = stdout, *stream = fopencookie(&outer, "w", io);
+
+	if (stream == NULL)
+		return (-1);
+
+	msh->expansion.data = NULL;
+	msh->expansion.len = msh->expansion.size = 0;
+	stdout = stream;
+	run_simple(msh, node);
+	fclose(stream);
+	stdout = out;
+
+	safe_free(msh->expansion.data);
+	msh->expansion = outer;
+	msh->sub_command = words;
+
+	return (0);
+}
+
+/**
+ * capture_child - runs a command tree in a forked copy of the shell,
+ * appending its output to msh->expansion
+ * @msh: contains all the data relevant to the shell's operation
+ * @tree: the command tree
+ *
+ * Description: The output is read from a pipe straight into the buffer,
+ * which grows so that every read can take up to what the pipe holds.
+ *
+ * Return: 0 on success, else -1 on failure
+ */
+static int capture_child(shell_t *msh, node_t *tree)
+{
+	buffer_t *buf = &msh->expansion;
+	ssize_t n = 1;
+	int fds[2];
+	pid_t pid;
+
+	if (pipe2(fds, O_CLOEXEC) == -1)
+		return (perror("pipe"), -1);
+	fflush(stdout); /* don't let the child inherit our pending output */
+	pid = fork();
+	if (pid == 0)
+	{
+		close(fds[0]);
+		dup2(fds[1], STDOUT_FILENO);
+		close(fds[1]);
+		reset_child_signals(msh);
+		execute_tree(msh, tree);
+		fflush(stdout);
+		_exit(msh->exit_code);
+	}
+
+	close(fds[1]);
+	while (pid != -1 && n != 0)
+	{
+		n = (buffer_reserve(buf, CAPTURE_READ) == -1) ? 0 :
+			read(fds[0], buf->data + buf->len, buf->size - buf->len);
+		if (n > 0)
+			buf->len += n;
+		else if (n == -1 && errno != EINTR)
+			n = 0;
+	}
+	close(fds[0]);
+	if (pid == -1)
+		return (perror("fork"), -1);
+	msh->exit_code = wait_command(pid);
+
+	return (0);
+}
+
+/**
+ * substitute_command - expands a $(...) command substitution, appending the
+ * output of the command to msh->expansion
+ * @msh: contains all the data relevant to the shell's operation
+ * @param: the substitution, starting with its '$'
+ *
+ * Description: The command is parsed on the spot. A simple command run by a
+ * BUILTIN_CAPTURE builtin without redirections runs in the shell, anything
+ * else in a forked copy of the shell, see capture_builtin() and
+ * capture_child(). Trailing newlines are removed from the output, and $? is
+ * the exit code of the command.
+ *
+ * Return: a pointer past the substitution, else NULL if it isn't terminated
+ * or on failure
+ */
+const char *substitute_command(shell_t *msh, const char *param)
+{
+	size_t len = braced_length(param), start = msh->expansion.len;
+	const builtin_t *builtin = NULL;
+	node_t *tree;
+	char *line;
+	int async = msh->async, status;
+
+	line = (len == 0) ? NULL : arena_strndup(&msh->arena, param + 2, len - 3);
+	if (line == NULL || build_tree(&msh->lexer, &msh->arena, line, &tree) != 0)
+		return (NULL);
+	if (tree == NULL)
+		return (param + len);
+
+	if (tree->type == NODE_CMD && tree->words != NULL &&
+			tree->redirs == NULL &&
+			find_alias(&msh->aliases, tree->words[0]) == NULL)
+		builtin = find_builtin(tree->words[0], _strlen(tree->words[0]));
+	msh->async = 0; /* `echo $(cmd) &` waits for cmd */
+	if (builtin != NULL && (builtin->flags & BUILTIN_CAPTURE))
+		status = capture_builtin(msh, tree);
+	else
+		status = capture_child(msh, tree);
+	msh->async = async;
+
+	while (msh->expansion.len > start &&
+			msh->expansion.data[msh->expansion.len - 1] == '\n')
+		msh->expansion.len--;
+
+	return ((status == -1) ? NULL : param + len);
+}
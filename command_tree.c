@@ -0,0 +1,178 @@
+#include "shell.h"
+
+/**
+ * new_node - creates a node of a command tree
+ * @arena: the arena to allocate the node from
+ * @type: the type of the node (one of the NODE_* macros)
+ * @left: the first operand of the node, if any
+ * @right: the second operand of the node, if any
+ *
+ * Return: the new node, else NULL on failure
+ */
+node_t *new_node(arena_t *arena, int type, node_t *left, node_t *right)
+{
+	node_t *node = arena_alloc(arena, sizeof(node_t));
+
+	if (node == NULL)
+		return (NULL);
+
+	node->type = type;
+	node->text = NULL;
+	node->words = NULL;
+	node->redirs = NULL;
+	node->left = left;
+	node->right = right;
+
+	return (node);
+}
+
+/**
+ * build_and_or - builds the and-or list of pipelines joined by the '&&' and
+ * '||' operators
+ * @lexer: the token stream, positioned at the first pipeline
+ * @arena: the arena to allocate the list from
+ *
+ * Description: The list is a chain of NODE_AND and NODE_OR nodes, one per
+ * operator, each holding the pipeline before its operator on the left and the
+ * rest of the list on the right. The last pipeline ends the chain, so
+ * `a && b || c` is (a && (b || c)), which execute_tree() walks from left to
+ * right without recursing.
+ *
+ * Return: the head of the list, else NULL on failure
+ */
+node_t *build_and_or(lexer_t *lexer, arena_t *arena)
+{
+	node_t *list = NULL, **tail = &list, *node;
+	int kind;
+
+	while ((node = build_timed(lexer, arena)) != NULL)
+	{
+		kind = lexer->tokens[lexer->pos].kind;
+		if (kind != TOK_AND && kind != TOK_OR)
+		{
+			*tail = node;
+			return (list);
+		}
+		lexer->pos++;
+		*tail = new_node(arena, (kind == TOK_AND) ? NODE_AND : NODE_OR, node,
+				NULL);
+		if (*tail == NULL)
+			return (NULL);
+		tail = &(*tail)->right;
+	}
+
+	return (NULL);
+}
+
+/**
+ * build_timed - builds the next pipeline of an and-or list, or the rest of
+ * the list when it starts with the `time` keyword
+ * @lexer: the token stream, positioned at the pipeline
+ * @arena: the arena to allocate the tree from
+ *
+ * Description: `time` times everything up to the end of the command, so
+ * `time a && b` puts the whole list under a NODE_TIME node. It is only a
+ * keyword when it is unquoted and followed by a command or by the end of
+ * the command, elsewhere it is the name of a command.
+ *
+ * Return: the root of the tree, else NULL on failure
+ */
+node_t *build_timed(lexer_t *lexer, arena_t *arena)
+{
+	token_t *token = &lexer->tokens[lexer->pos];
+	node_t *list = NULL;
+
+	if (token->kind != TOK_WORD || token->length != 4 ||
+			_strncmp(lexer->line + token->offset, "time", 4) ||
+			token[1].kind == TOK_AND || token[1].kind == TOK_OR ||
+			token[1].kind == TOK_PIPE)
+		return (build_pipeline(lexer, arena));
+
+	lexer->pos++;
+	if (token[1].kind == TOK_WORD)
+	{
+		list = build_and_or(lexer, arena);
+		if (list == NULL)
+			return (NULL);
+	}
+
+	return (new_node(arena, NODE_TIME, list, NULL));
+}
+
+/**
+ * build_pipeline - builds the tree of a pipeline (cmd1 | cmd2 | ...)
+ * @lexer: the token stream, positioned at the first stage
+ * @arena: the arena to allocate the tree from
+ *
+ * Return: the root of the tree, else NULL on failure
+ */
+node_t *build_pipeline(lexer_t *lexer, arena_t *arena)
+{
+	node_t *stage = build_simple(lexer, arena), *rest;
+
+	if (stage == NULL || lexer->tokens[lexer->pos].kind != TOK_PIPE)
+		return (stage);
+
+	lexer->pos++;
+	rest = build_pipeline(lexer, arena);
+	if (rest == NULL)
+		return (NULL);
+
+	return (new_node(arena, NODE_PIPE, stage, rest));
+}
+
+/**
+ * build_simple - builds the node of a simple command out of the words and
+ * redirections at the current position of a token stream
+ * @lexer: the token stream
+ * @arena: the arena to allocate the node from
+ *
+ * Description: The words point into the line, build_tree() null-terminates
+ * them once the whole line is parsed. The source text is only copied for the
+ * BUILTIN_SOURCE builtins without redirections, which parse it themselves.
+ *
+ * Return: the new node, its words are NULL when there are no words, else
+ * NULL on failure
+ */
+node_t *build_simple(lexer_t *lexer, arena_t *arena)
+{
+	token_t *token = &lexer->tokens[lexer->pos], *word = NULL;
+	char *line = (char *)lexer->line;
+	const builtin_t *builtin;
+	node_t *node = new_node(arena, NODE_CMD, NULL, NULL);
+	size_t count = 0;
+
+	for (; node != NULL && (token->kind == TOK_WORD ||
+				token->kind == TOK_REDIR); token++)
+		if (token->kind == TOK_REDIR)
+		{
+			if (add_redir(lexer, arena, node, token++) == -1)
+				return (NULL);
+		}
+		else if (count++ == 0)
+			word = token;
+	lexer->pos = token - lexer->tokens;
+	if (node == NULL || count == 0)
+		return (node);
+
+	builtin = find_builtin(line + word->offset, word->length);
+	if (builtin != NULL && (builtin->flags & BUILTIN_SOURCE) &&
+			node->redirs == NULL)
+	{
+		node->text = arena_strndup(arena, line + word->offset,
+			token[-1].offset + token[-1].length - word->offset);
+		if (node->text == NULL)
+			return (NULL);
+	}
+	node->words = arena_alloc(arena, sizeof(char *) * (count + 1));
+	if (node->words == NULL)
+		return (NULL);
+	for (count = 0; word < token; word++)
+		if (word->kind == TOK_REDIR)
+			word++;
+		else /* the line is cut into words by build_tree() */
+			node->words[count++] = line + word->offset;
+	node->words[count] = NULL;
+
+	return (node);
+}
@@ -0,0 +1,109 @@
+#include "shell.h"
+
+/**
+ * get_escape - decodes a backslash escape sequence of echo and printf
+ * @s: the sequence, right after the backslash
+ * @zero_octal: true if octal sequences start with a 0 (\0ddd, in echo and
+ * printf's %b), else they are \ddd (in printf formats)
+ * @c: where to store the character, -1 for \c, which ends the output
+ *
+ * Description: \\, \a, \b, \f, \n, \r, \t, \v and octal sequences of up to 3
+ * digits stand for a single character, any other backslash for itself.
+ *
+ * Return: a pointer past the sequence
+ */
+const char *get_escape(const char *s, int zero_octal, int *c)
+{
+	const char *escapes = "\\\\a\ab\bf\fn\nr\rt\tv\v";
+	int i;
+
+	*c = '\\';
+	if (*s == 'c')
+	{
+		*c = -1;
+		return (s + 1);
+	}
+	for (i = 0; *s != '\0' && escapes[i] != '\0'; i += 2)
+		if (escapes[i] == *s)
+		{
+			*c = (unsigned char)escapes[i + 1];
+			return (s + 1);
+		}
+
+	if ((zero_octal) ? *s == '0' : (*s >= '0' && *s <= '7'))
+	{
+		s += zero_octal;
+		for (*c = i = 0; i < 3 && *s >= '0' && *s <= '7'; i++, s++)
+			*c = (*c * 8 + *s - '0') & 0xff;
+	}
+
+	return (s); /* an unknown sequence leaves the character after it */
+}
+
+/**
+ * handle_echo - handles the builtin `echo` command
+ * @msh: contains all the data relevant to the shell's operation
+ *
+ * Description: The arguments are written separated by spaces and followed by
+ * a newline, through the buffered standard output. As in the XSI form of
+ * echo, backslash escape sequences are decoded, \c ends the output, and a
+ * first argument of -n leaves the newline out.
+ *
+ * Return: always 0
+ */
+int handle_echo(shell_t *msh)
+{
+	char **args = msh->sub_command + 1;
+	const char *s;
+	size_t len;
+	int c, newline = 1;
+
+	if (*args != NULL && !_strcmp(*args, "-n"))
+	{
+		newline = 0;
+		args++;
+	}
+	for (; *args != NULL; args++)
+	{
+		for (s = *args; *s != '\0';)
+		{
+			len = string_span(s, "\\", 0);
+			fwrite(s, 1, len, stdout);
+			s += len;
+			if (*s == '\0')
+				break;
+			s = get_escape(s + 1, 1, &c);
+			if (c == -1)
+				return (0);
+			putchar(c);
+		}
+		if (args[1] != NULL)
+			putchar(SPACE);
+	}
+	if (newline)
+		putchar('\n');
+
+	return (0);
+}
+
+/**
+ * handle_true - handles the builtin `true` command
+ * @msh: contains all the data relevant to the shell's operation (unused)
+ *
+ * Return: always 0
+ */
+int handle_true(__attribute__((unused))shell_t *msh)
+{
+	return (0);
+}
+
+/**
+ * handle_false - handles the builtin `false` command
+ * @msh: contains all the data relevant to the shell's operation (unused)
+ *
+ * Return: always 1
+ */
+int handle_false(__attribute__((unused))shell_t *msh)
+{
+	return (1);
+}
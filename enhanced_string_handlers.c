@@ -29,7 +29,7 @@ int _strncmp(const char *s1, const char *s2, size_t n)
 }
 
 /**
- * _strchr - locate character in string
+ * strchr_scalar - locate character in string
  * @s: the string
  * @c: the character to search
  *
@@ -39,7 +39,7 @@ int _strncmp(const char *s1, const char *s2, size_t n)
  * Return: a pointer to the matched character or NULL if the character
  * is not found
  */
-char *_strchr(const char *s, int c)
+char *strchr_scalar(const char *s, int c)
 {
 	char *tmp_s = (char *)s;
 
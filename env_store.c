@@ -0,0 +1,156 @@
+#include "shell.h"
+
+static env_store_t env_store; /* the shell's environment */
+
+/**
+ * get_env_store - returns the shell's variable store
+ *
+ * Return: a pointer to the variable store
+ */
+env_store_t *get_env_store(void)
+{
+	return (&env_store);
+}
+
+/**
+ * init_env - loads the environment the shell was started with into the
+ * variable store
+ *
+ * Return: 0 on success, else -1 if memory allocation failed
+ */
+int init_env(void)
+{
+	size_t i, size = ENV_MIN_BUCKETS;
+	char *entry, *equal_sign, **initial_env = environ;
+	var_t *var;
+
+	for (i = 0; initial_env != NULL && initial_env[i] != NULL; i++)
+		;
+	while (size < i * 2)
+		size *= 2; /* keep the load factor under 0.5 to start with */
+	if (resize_env_store(&env_store, size) == -1)
+		return (-1);
+
+	for (i = 0; initial_env != NULL && initial_env[i] != NULL; i++)
+	{
+		equal_sign = _strchr(initial_env[i], '=');
+		if (equal_sign == NULL)
+			continue; /* not a valid variable */
+		entry = _strdup(initial_env[i]);
+		if (entry == NULL)
+			return (-1);
+		var = find_var(initial_env[i], equal_sign - initial_env[i]);
+		if (var != NULL)
+		{
+			retire_entry(var->entry); /* the last definition wins */
+			var->entry = entry;
+		}
+		else if (add_var(entry, equal_sign - initial_env[i]) == NULL)
+			return (safe_free(entry), -1);
+	}
+
+	return (0);
+}
+
+/**
+ * find_var - looks up a variable in the variable store
+ * @name: the name of the variable, it doesn't need to be null-terminated
+ * @name_len: the length of the name
+ *
+ * Return: the variable if found, else NULL
+ */
+var_t *find_var(const char *name, size_t name_len)
+{
+	size_t hash;
+	var_t *var;
+
+	if (env_store.buckets == NULL)
+		return (NULL);
+
+	hash = hash_bytes(name, name_len);
+	for (var = env_store.buckets[hash & (env_store.size - 1)]; var != NULL;
+			var = var->next)
+	{
+		if (var->hash == hash && var->name_len == name_len &&
+				!_strncmp(var->entry, name, name_len))
+			return (var);
+	}
+
+	return (NULL);
+}
+
+/**
+ * add_var - adds a new variable to the variable store
+ * @entry: the variable as a dynamically allocated "NAME=value" string, the
+ * store takes ownership of it
+ * @name_len: the length of the NAME part of @entry
+ *
+ * Description: The variable must not exist in the store yet.
+ *
+ * Return: the new variable, else NULL if memory allocation failed
+ */
+var_t *add_var(char *entry, size_t name_len)
+{
+	var_t *var;
+	size_t index;
+
+	if (env_store.count + 1 > env_store.size / 4 * 3 &&
+			resize_env_store(&env_store, env_store.size * 2) == -1)
+		return (NULL);
+
+	var = malloc(sizeof(var_t));
+	if (var == NULL)
+		return (NULL);
+
+	var->entry = entry;
+	var->name_len = name_len;
+	var->hash = hash_bytes(entry, name_len);
+
+	index = var->hash & (env_store.size - 1);
+	var->next = env_store.buckets[index];
+	env_store.buckets[index] = var;
+
+	var->prev_var = env_store.last;
+	var->next_var = NULL;
+	if (env_store.last != NULL)
+		env_store.last->next_var = var;
+	else
+		env_store.first = var;
+	env_store.last = var;
+	env_store.count++;
+	mark_env_changed();
+
+	return (var);
+}
+
+/**
+ * resize_env_store - changes the number of buckets of the variable store
+ * @store: the variable store
+ * @size: the new number of buckets, it must be a power of two
+ *
+ * Return: 0 on success, else -1 if memory allocation failed
+ */
+int resize_env_store(env_store_t *store, size_t size)
+{
+	var_t **buckets, *var;
+	size_t i;
+
+	buckets = malloc(sizeof(var_t *) * size);
+	if (buckets == NULL)
+		return (-1);
+	for (i = 0; i < size; i++)
+		buckets[i] = NULL;
+
+	/* the definition order links all the variables together */
+	for (var = store->first; var != NULL; var = var->next_var)
+	{
+		var->next = buckets[var->hash & (size - 1)];
+		buckets[var->hash & (size - 1)] = var;
+	}
+
+	safe_free(store->buckets);
+	store->buckets = buckets;
+	store->size = size;
+
+	return (0);
+}
@@ -0,0 +1,142 @@
+#include "shell.h"
+
+/**
+ * delete_var - removes a variable from the variable store
+ * @var: the variable to remove
+ */
+void delete_var(var_t *var)
+{
+	env_store_t *store = get_env_store();
+	var_t **current = &store->buckets[var->hash & (store->size - 1)];
+
+	while (*current != var)
+		current = &(*current)->next;
+	*current = var->next;
+
+	if (var->prev_var != NULL)
+		var->prev_var->next_var = var->next_var;
+	else
+		store->first = var->next_var;
+	if (var->next_var != NULL)
+		var->next_var->prev_var = var->prev_var;
+	else
+		store->last = var->prev_var;
+
+	store->count--;
+	mark_env_changed();
+	retire_entry(var->entry);
+	safe_free(var);
+}
+
+/**
+ * retire_entry - frees the "NAME=value" string of a variable that was
+ * replaced or removed, once `environ` can't point to it anymore
+ * @entry: the string
+ *
+ * Description: `environ` points to the last envp array built, which is only
+ * rebuilt when a program is run, see get_envp(). Until then the strings it
+ * holds are kept on a list, so getenv() keeps working on the old values.
+ * If the list can't grow, `environ` is detached from the store instead.
+ */
+void retire_entry(char *entry)
+{
+	env_store_t *store = get_env_store();
+	size_t size = store->retired_size;
+	char **retired;
+
+	if (environ == NULL || environ != store->envp)
+	{
+		safe_free(entry); /* environ doesn't hold our strings */
+		return;
+	}
+	if (store->retired_count == size)
+	{
+		size = (size == 0) ? ENV_MIN_BUCKETS : size * 2;
+		retired = _realloc(store->retired, sizeof(char *) *
+				store->retired_size, sizeof(char *) * size);
+		if (retired == NULL)
+		{
+			environ = NULL;
+			safe_free(entry);
+			return;
+		}
+		store->retired = retired;
+		store->retired_size = size;
+	}
+	store->retired[store->retired_count++] = entry;
+}
+
+/**
+ * mark_env_changed - records that the variables changed
+ *
+ * Description: Setting and unsetting variables stays O(1): the environment
+ * handed to programs is only rebuilt by the next get_envp().
+ */
+void mark_env_changed(void)
+{
+	env_store_t *store = get_env_store();
+
+	store->changed = 1;
+	store->generation++;
+}
+
+/**
+ * get_envp - returns the environment in the form handed to programs
+ *
+ * Description: The array is only rebuilt when the variables changed since
+ * the last time it was built, so running commands in a row costs nothing.
+ * `environ` is pointed at it as well, and the strings it held for variables
+ * that changed since are freed, see retire_entry().
+ *
+ * Return: a NULL-terminated array of "NAME=value" strings, else NULL if
+ * memory allocation failed
+ */
+char **get_envp(void)
+{
+	env_store_t *store = get_env_store();
+	char **envp;
+	var_t *var;
+	size_t i = 0;
+
+	if (!store->changed && store->envp != NULL)
+		return (environ = store->envp);
+
+	if (store->envp == NULL || store->envp_size < store->count + 1)
+	{
+		envp = malloc(sizeof(char *) * (store->count * 2 + 1));
+		if (envp == NULL)
+			return (NULL);
+		safe_free(store->envp);
+		store->envp = envp;
+		store->envp_size = store->count * 2 + 1;
+	}
+
+	for (var = store->first; var != NULL; var = var->next_var)
+		store->envp[i++] = var->entry;
+	store->envp[i] = NULL;
+	store->changed = 0;
+	environ = store->envp;
+	while (store->retired_count > 0)
+		safe_free(store->retired[--store->retired_count]);
+
+	return (environ);
+}
+
+/**
+ * free_env - frees the variable store
+ */
+void free_env(void)
+{
+	env_store_t *store = get_env_store();
+
+	environ = NULL; /* the strings are freed right away */
+	while (store->first != NULL)
+		delete_var(store->first);
+	while (store->retired_count > 0)
+		safe_free(store->retired[--store->retired_count]);
+
+	safe_free(store->buckets);
+	safe_free(store->envp);
+	safe_free(store->retired);
+	store->size = store->envp_size = store->retired_size = 0;
+}
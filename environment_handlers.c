@@ -9,20 +9,17 @@
  */
 char *_getenv(const char *name)
 {
-	int i;
-	size_t len = _strlen(name);
+	var_t *var;
 
-	for (i = 0; environ[i] != NULL; i++)
-	{
-		/* check if we found a match */
-		if (_strstr(environ[i], name) && environ[i][len] == '=')
-		{
-			/* move past the equal to sign and return the actual value */
-			return ((_strchr(environ[i], '=')) + 1);
-		}
-	}
+	if (name == NULL)
+		return (NULL);
+
+	var = find_var(name, _strlen(name));
+	if (var == NULL)
+		return (NULL);
 
-	return (NULL);
+	/* move past the equal to sign and return the actual value */
+	return (var->entry + var->name_len + 1);
 }
 
 /**
@@ -21,29 +21,6 @@ void free_list(path_t **head)
 	}
 }
 
-/**
- * free_aliases - frees an alias_t list
- * @head: a pointer to the list containing the aliases
- */
-void free_aliases(alias_t **head)
-{
-	alias_t *current;
-
-	if (*head == NULL || head == NULL)
-		return;
-
-	while (*head != NULL)
-	{
-		current = (*head);
-		(*head) = (*head)->next;
-
-		/* free memory */
-		safe_free(current->name);
-		safe_free(current->value);
-		safe_free(current);
-	}
-}
-
 /**
  * multi_free - frees dynamically allocated memory
  * @format: the format of how dynamically allocated variables are given
@@ -51,7 +28,7 @@ void free_aliases(alias_t **head)
  * Description: 's' is for a normal string (char *)
  *				't' is for an array of strings (char **)
  *				'p' is for the path_t list
- *				'a' is for the alias_t list
+ *				'a' is for the alias store
  */
 void multi_free(const char *format, ...)
 {
@@ -75,7 +52,7 @@ void multi_free(const char *format, ...)
 			free_list(va_arg(ap, path_t **));
 			break;
 		case 'a':
-			free_aliases(va_arg(ap, alias_t **));
+			free_aliases(va_arg(ap, alias_store_t *));
 			break;
 		default:
 			break;
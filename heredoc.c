@@ -0,0 +1,200 @@
+#include "shell.h"
+
+/**
+ * unquote_delimiter - removes the quotes and backslashes of the delimiter of
+ * a here-document, in place
+ * @word: the delimiter
+ *
+ * Return: 1 if the delimiter had any, else 0
+ */
+static int unquote_delimiter(char *word)
+{
+	char *end = word, quote = '\0';
+	int quoted = 0;
+
+	for (; *word != '\0'; word++)
+	{
+		if (*word == quote || (quote == '\0' && isquote(*word)))
+		{
+			quote = (quote == '\0') ? *word : '\0';
+			quoted = 1;
+			continue;
+		}
+		if (*word == '\\' && quote != '\'' && word[1] != '\0' &&
+				(quote == '\0' || _strchr("$`\"\\\n", word[1])))
+		{
+			quoted = 1;
+			word++; /* the next character stands for itself */
+		}
+		*end++ = *word;
+	}
+	*end = '\0';
+
+	return (quoted);
+}
+
+/**
+ * read_heredoc - reads the body of a here-document from the shell's input
+ * @msh: contains all the data relevant to the shell's operation
+ * @redir: the redirection, its target is the delimiter
+ *
+ * Description: The body is every line up to the delimiter or the end of the
+ * input, without the leading tabs for `<<-`. It replaces the target of the
+ * redirection, which becomes a REDIR_HEREDOC, or a REDIR_HEREDOC_RAW if the
+ * delimiter was quoted and the body must not be expanded.
+ *
+ * Return: 0 on success, else -1 on failure
+ */
+static int read_heredoc(shell_t *msh, redir_t *redir)
+{
+	buffer_t *body = &msh->expansion; /* no words are expanded yet */
+	char *delim = redir->target, *line = NULL;
+	int quoted = unquote_delimiter(delim);
+	size_t n = 0, len = _strlen(delim), i;
+	ssize_t n_read = 0;
+
+	body->len = 0;
+	while (msh->input != NULL && n_read != -1)
+	{
+		if (msh->interactive)
+		{
+			fputs("> ", stdout);
+			fflush(stdout);
+		}
+		n_read = read_line(msh->input, &line, &n);
+		if (n_read <= 0)
+			break;
+		++msh->cmd_count; /* errors are reported with the line number */
+		i = (redir->type == REDIR_DELIM) ? 0 : _strspn(line, "\t");
+		if (!_strncmp(line + i, delim, len) &&
+				(line[i + len] == '\n' || !line[i + len]))
+			break;
+		if (buffer_write(body, line + i, n_read - i) == -1)
+			n_read = -1;
+	}
+	safe_free(line);
+
+	redir->type = (quoted) ? REDIR_HEREDOC_RAW : REDIR_HEREDOC;
+	redir->target = arena_strndup(&msh->arena, (body->len == 0) ? ""
+			: body->data, body->len);
+
+	return ((redir->target == NULL || n_read == -1) ? -1 : 0);
+}
+
+/**
+ * read_heredocs - reads the bodies of the here-documents of a command tree,
+ * in the order they appear on the command line
+ * @msh: contains all the data relevant to the shell's operation
+ * @node: the root of the tree
+ *
+ * Return: 0 on success, else -1 on failure
+ */
+int read_heredocs(shell_t *msh, node_t *node)
+{
+	redir_t *redir;
+
+	for (; node != NULL; node = node->right)
+	{
+		for (redir = node->redirs; redir != NULL; redir = redir->next)
+			if (redir->type >= REDIR_DELIM &&
+					read_heredoc(msh, redir) == -1)
+				return (-1);
+		if (read_heredocs(msh, node->left) == -1)
+			return (-1);
+	}
+
+	return (0);
+}
+
+/**
+ * expand_heredoc - expands the parameters of the body of a here-document
+ * into msh->target
+ * @msh: contains all the data relevant to the shell's operation
+ * @body: the body
+ *
+ * Description: Quotes are left alone, and a backslash only escapes '$', '`',
+ * '\' and newlines, as inside double quotes.
+ *
+ * Return: 0 on success, else -1 on a bad substitution or if memory
+ * allocation failed
+ */
+static int expand_heredoc(shell_t *msh, const char *body)
+{
+	buffer_t words = msh->expansion; /* the words of the command */
+	const char *next;
+	int quoted, status = 0;
+
+	msh->expansion = msh->target;
+	msh->expansion.len = 0;
+	for (; *body != '\0' && status == 0; body++)
+	{
+		if (*body == '\\' && body[1] != '\0' &&
+				_strchr("$`\\\n", body[1]) != NULL)
+		{
+			if (*++body == '\n')
+				continue; /* a line continuation */
+		}
+		else if (*body == '$' &&
+				(next = expand_param(msh, body + 1, &quoted)) !=
+				body + 1)
+		{
+			if (next == NULL)
+				status = -1;
+			else
+				body = next - 1;
+			continue;
+		}
+		status = buffer_putc(&msh->expansion, *body);
+	}
+	msh->target = msh->expansion;
+	msh->expansion = words;
+
+	return (status);
+}
+
+/**
+ * heredoc_fd - creates the file a here-document is read from
+ * @msh: contains all the data relevant to the shell's operation
+ * @redir: the redirection
+ *
+ * Description: The body is written to an anonymous file in memory, from
+ * memfd_create(), which is then read from the start like a regular file. No
+ * temporary file is created and the body needs no pipe, so it can be of any
+ * size. A here-document whose body couldn't be read, e.g. in a command
+ * substitution, is empty.
+ *
+ * Return: the file descriptor, else -1 on failure
+ */
+int heredoc_fd(shell_t *msh, redir_t *redir)
+{
+	struct iovec iov = {"", 0};
+	int fd;
+
+	if (redir->type == REDIR_HEREDOC &&
+			expand_heredoc(msh, redir->target) == -1)
+	{
+		print_error(msh, "Bad substitution\n");
+		return (-1);
+	}
+	if (redir->type == REDIR_HEREDOC)
+	{
+		iov.iov_base = msh->target.data;
+		iov.iov_len = msh->target.len;
+	}
+	else if (redir->type == REDIR_HEREDOC_RAW)
+	{
+		iov.iov_base = redir->target;
+		iov.iov_len = _strlen(redir->target);
+	}
+
+	fd = memfd_create("msh-heredoc", MFD_CLOEXEC);
+	if (fd != -1 && writev_all(fd, &iov, 1) == 0 &&
+			lseek(fd, 0, SEEK_SET) == 0)
+		return (fd);
+
+	print_error(msh, "cannot create here-document: %s\n", strerror(errno));
+	if (fd != -1)
+		close(fd);
+
+	return (-1);
+}
@@ -0,0 +1,119 @@
+#include "shell.h"
+
+/**
+ * remove_job - removes a job from the job table
+ * @msh: contains all the data relevant to the shell's operation
+ * @job: the job to remove
+ */
+void remove_job(shell_t *msh, job_t *job)
+{
+	job_t **current;
+	sigset_t old_mask;
+
+	block_sigchld(SIG_BLOCK, &old_mask);
+	for (current = &msh->jobs; *current != NULL; current = &(*current)->next)
+	{
+		if (*current == job)
+		{
+			*current = job->next;
+			break;
+		}
+	}
+	block_sigchld(SIG_SETMASK, &old_mask);
+
+	safe_free(job->command);
+	safe_free(job);
+}
+
+/**
+ * find_job - finds a job from a job specification
+ * @msh: contains all the data relevant to the shell's operation
+ * @spec: the job specification: %n for job number n, %% or %+ (or NULL) for
+ * the current job, %- for the previous job, or the process ID of a job
+ *
+ * Return: the job if found, else NULL
+ */
+job_t *find_job(shell_t *msh, const char *spec)
+{
+	job_t *job, *previous = NULL;
+
+	if (spec == NULL || !_strcmp(spec, "%%") || !_strcmp(spec, "%+") ||
+			!_strcmp(spec, "%-"))
+	{
+		for (job = msh->jobs; job != NULL && job->next != NULL;
+				job = job->next)
+			previous = job;
+		return ((spec != NULL && !_strcmp(spec, "%-")) ? previous : job);
+	}
+
+	for (job = msh->jobs; job != NULL; job = job->next)
+	{
+		if (*spec == '%' && isdigit(spec[1]) &&
+				job->id == (size_t)_atoi(spec + 1))
+			return (job);
+		if (isdigit(*spec) && (job->last_pid == _atoi(spec) ||
+					job->pgid == _atoi(spec)))
+			return (job);
+	}
+
+	return (NULL);
+}
+
+/**
+ * print_job - prints the state of a job, the way the `jobs` builtin does
+ * @msh: contains all the data relevant to the shell's operation
+ * @job: the job to print
+ */
+void print_job(shell_t *msh, job_t *job)
+{
+	char marker = ' ', state[32];
+
+	if (job == find_job(msh, "%+"))
+		marker = '+';
+	else if (job == find_job(msh, "%-"))
+		marker = '-';
+
+	if (job->state == JOB_RUNNING)
+		sprintf(state, "Running");
+	else if (job->state == JOB_STOPPED)
+		sprintf(state, "Stopped");
+	else if (job->status == 0)
+		sprintf(state, "Done");
+	else
+		sprintf(state, "Done(%d)", (int)job->status);
+
+	printf("[%lu]%c  %-24s%s%s\n", job->id, marker, state, job->command,
+			(job->state == JOB_RUNNING) ? " &" : "");
+}
+
+/**
+ * report_jobs - reports the jobs that are done and removes them from the job
+ * table, this happens before the prompt is shown in interactive mode
+ * @msh: contains all the data relevant to the shell's operation
+ */
+void report_jobs(shell_t *msh)
+{
+	job_t *job = msh->jobs, *next;
+
+	while (job != NULL)
+	{
+		next = job->next;
+		if (job->state == JOB_DONE)
+		{
+			print_job(msh, job);
+			remove_job(msh, job);
+		}
+		job = next;
+	}
+	fflush(stdout);
+}
+
+/**
+ * free_jobs - frees the job table, the jobs themselves keep running
+ * @msh: contains all the data relevant to the shell's operation
+ */
+void free_jobs(shell_t *msh)
+{
+	while (msh->jobs != NULL)
+		remove_job(msh, msh->jobs);
+}
@@ -0,0 +1,156 @@
+#include "shell.h"
+
+static shell_t *job_shell; /* the shell whose jobs the SIGCHLD handler reaps */
+
+/**
+ * init_jobs - prepares the shell for running background jobs
+ * @msh: contains all the data relevant to the shell's operation
+ *
+ * Description: Background jobs are reaped asynchronously by the SIGCHLD
+ * handler, so the main loop never has to stop to collect them.
+ */
+void init_jobs(shell_t *msh)
+{
+	struct sigaction action;
+
+	job_shell = msh;
+	action.sa_handler = sigchld_handler;
+	sigemptyset(&action.sa_mask);
+	action.sa_flags = SA_RESTART;
+	sigaction(SIGCHLD, &action, NULL);
+
+	/* let `fg` hand the terminal over to a job and take it back */
+	if (msh->interactive)
+		signal(SIGTTOU, SIG_IGN);
+}
+
+/**
+ * sigchld_handler - reaps the background jobs that changed state
+ * @signum: signal number (unused)
+ */
+void sigchld_handler(__attribute__((unused))int signum)
+{
+	int saved_errno = errno;
+	job_t *job;
+
+	for (job = job_shell->jobs; job != NULL; job = job->next)
+		reap_job(job);
+
+	errno = saved_errno;
+}
+
+/**
+ * reap_job - collects the processes of a job that changed state, if any
+ * @job: the job to reap
+ *
+ * Description: This never blocks, it is safe to call from the SIGCHLD
+ * handler. Foreground commands are never touched since they are not in the
+ * process group of any job.
+ */
+void reap_job(job_t *job)
+{
+	int status;
+	pid_t pid = 0;
+
+	while (job->state != JOB_DONE &&
+			(pid = waitpid(-job->pgid, &status,
+				WNOHANG | WUNTRACED | WCONTINUED)) > 0)
+	{
+		if (WIFSTOPPED(status))
+		{
+			job->state = JOB_STOPPED;
+			job->status = 128 + WSTOPSIG(status); /* what `wait` returns */
+		}
+		else if (WIFCONTINUED(status))
+			job->state = JOB_RUNNING;
+		else
+		{
+			if (pid == job->last_pid)
+				job->status = WIFEXITED(status) ? WEXITSTATUS(status)
+					: 128 + WTERMSIG(status);
+			job->procs--;
+			if (job->procs <= 0)
+				job->state = JOB_DONE;
+		}
+	}
+
+	/* there's nothing left to wait for, the job can't be running anymore */
+	if (job->state != JOB_DONE && pid == -1 && errno == ECHILD)
+		job->state = JOB_DONE;
+}
+
+/**
+ * add_job - adds a job that was just started to the job table
+ * @msh: contains all the data relevant to the shell's operation
+ * @pgid: the process group ID of the job
+ * @last_pid: the process ID of the last command of the job
+ * @procs: the number of processes the job is made of
+ *
+ * Return: 0 on success, else 1 if the job couldn't be added
+ */
+int add_job(shell_t *msh, pid_t pgid, pid_t last_pid, int procs)
+{
+	job_t *job = malloc(sizeof(job_t)), *tail = msh->jobs;
+	sigset_t old_mask;
+
+	if (job == NULL || (job->command = _strdup(msh->job_command)) == NULL)
+	{
+		safe_free(job);
+		print_error(msh, "Memory allocation failed\n");
+		return (1);
+	}
+	job->pgid = pgid;
+	job->last_pid = last_pid;
+	job->procs = procs;
+	job->state = JOB_RUNNING;
+	job->status = 0;
+	job->next = NULL;
+
+	block_sigchld(SIG_BLOCK, &old_mask);
+	while (tail != NULL && tail->next != NULL)
+		tail = tail->next;
+	job->id = (tail == NULL) ? 1 : tail->id + 1;
+	if (tail == NULL)
+		msh->jobs = job;
+	else
+		tail->next = job;
+	reap_job(job); /* it may have finished before we knew about it */
+	block_sigchld(SIG_SETMASK, &old_mask);
+
+	msh->last_bg_pid = last_pid;
+	if (msh->interactive)
+		fprintf(stderr, "[%lu] %d\n", job->id, last_pid);
+
+	return (0);
+}
+
+/**
+ * start_pipeline_job - adds a pipeline started in the background to the job
+ * table
+ * @msh: contains all the data relevant to the shell's operation
+ * @pids: the process IDs of the stages, negative for stages that failed
+ * @count: the number of stages
+ *
+ * Return: 0 on success, else the exit code of the pipeline if none of its
+ * stages could be started
+ */
+int start_pipeline_job(shell_t *msh, pid_t *pids, size_t count)
+{
+	size_t i;
+	int procs = 0;
+	pid_t last_pid = 0;
+
+	for (i = 0; i < count; i++)
+	{
+		if (pids[i] > 0)
+		{
+			procs++;
+			last_pid = pids[i];
+		}
+	}
+
+	if (procs == 0)
+		return ((count > 0) ? -pids[count - 1] : 0);
+
+	return (add_job(msh, msh->job_pgid, last_pid, procs));
+}
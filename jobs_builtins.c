@@ -0,0 +1,203 @@
+#include "shell.h"
+
+/**
+ * handle_jobs - handles the builtin `jobs` command
+ * @msh: contains all the data relevant to the shell's operation
+ *
+ * Description: Jobs that are done are removed once they have been listed.
+ *
+ * Return: 0 on success, else 1 if a given job was not found
+ */
+int handle_jobs(shell_t *msh)
+{
+	size_t i;
+	job_t *job, *next;
+	int exit_code = 0;
+
+	for (i = 1; msh->sub_command[i] != NULL; i++)
+	{
+		job = find_job(msh, msh->sub_command[i]);
+		if (job == NULL)
+		{
+			print_error(msh, "jobs: %s: no such job\n", msh->sub_command[i]);
+			exit_code = 1;
+			continue;
+		}
+		print_job(msh, job);
+		if (job->state == JOB_DONE)
+			remove_job(msh, job);
+	}
+
+	for (job = msh->jobs; i == 1 && job != NULL; job = next)
+	{
+		next = job->next;
+		print_job(msh, job);
+		if (job->state == JOB_DONE)
+			remove_job(msh, job);
+	}
+
+	return (exit_code);
+}
+
+/**
+ * handle_wait - handles the builtin `wait` command
+ * @msh: contains all the data relevant to the shell's operation
+ *
+ * Description: With no arguments, all the jobs are waited for, except the
+ * stopped ones, which are left in the table for `fg` and `bg`. `wait -n`
+ * waits for the next job to finish, and any other argument is a job
+ * specification (%n or a process ID) of a job to wait for. Waiting for a
+ * stopped job returns at once.
+ *
+ * Return: the exit code of the last job waited for, 128 plus the signal that
+ * stopped it, or 127 if it was not found or `wait -n` had no running job
+ */
+int handle_wait(shell_t *msh)
+{
+	size_t i;
+	job_t *job, *next;
+	int exit_code = 0, any = 0;
+
+	for (job = msh->jobs; msh->sub_command[1] == NULL && job != NULL;
+			job = next)
+	{
+		next = job->next;
+		wait_job(msh, job);
+		if (job->state == JOB_DONE)
+			remove_job(msh, job);
+	}
+	if (msh->sub_command[1] == NULL)
+		return (0);
+
+	for (i = 1; msh->sub_command[i] != NULL; i++)
+	{
+		any = !_strcmp(msh->sub_command[i], "-n");
+		job = (any) ? NULL : find_job(msh, msh->sub_command[i]);
+		if (!any && job == NULL)
+		{
+			print_error(msh, "wait: %s: no such job\n", msh->sub_command[i]);
+			exit_code = CMD_NOT_FOUND;
+			continue;
+		}
+		job = wait_job(msh, job);
+		exit_code = (job != NULL) ? job->status : CMD_NOT_FOUND;
+		if (job != NULL && job->state == JOB_DONE)
+			remove_job(msh, job);
+	}
+
+	return (exit_code);
+}
+
+/**
+ * wait_job - waits for a job to stop running
+ * @msh: contains all the data relevant to the shell's operation
+ * @job: the job to wait for, or NULL to wait for any job to finish
+ *
+ * Description: The shell sleeps in sigsuspend() while the SIGCHLD handler
+ * does the actual reaping. A stopped job is returned as it is, and when no
+ * job is left running, waiting for any of them gives up at once.
+ *
+ * Return: the job that stopped running, or NULL if there are no jobs, or
+ * none of them is running when @job is NULL
+ */
+job_t *wait_job(shell_t *msh, job_t *job)
+{
+	sigset_t old_mask;
+	job_t *current = NULL;
+	int running;
+
+	block_sigchld(SIG_BLOCK, &old_mask);
+	while (msh->jobs != NULL)
+	{
+		if (job != NULL)
+			current = (job->state != JOB_RUNNING) ? job : NULL;
+		else
+		{
+			running = 0;
+			for (current = msh->jobs; current != NULL; current = current->next)
+			{
+				if (current->state == JOB_DONE)
+					break;
+				running |= (current->state == JOB_RUNNING);
+			}
+			if (current == NULL && !running)
+				break; /* every job is stopped */
+		}
+		if (current != NULL)
+			break;
+		sigsuspend(&old_mask);
+	}
+	block_sigchld(SIG_SETMASK, &old_mask);
+
+	return (current);
+}
+
+/**
+ * handle_fg_bg - handles the builtin `fg` and `bg` commands
+ * @msh: contains all the data relevant to the shell's operation
+ *
+ * Description: Both continue a stopped job. `bg` lets it run in the
+ * background while `fg` waits for it, giving it the terminal in interactive
+ * mode.
+ *
+ * Return: the exit code of the job for `fg`, 0 for `bg`, else 1 on error
+ */
+int handle_fg_bg(shell_t *msh)
+{
+	job_t *job = find_job(msh, msh->sub_command[1]);
+	int interactive = msh->interactive, exit_code;
+
+	if (job == NULL)
+	{
+		print_error(msh, "%s: %s: no such job\n", msh->sub_command[0],
+				(msh->sub_command[1]) ? msh->sub_command[1] : "current");
+		return (1);
+	}
+
+	if (*msh->sub_command[0] == 'b')
+		printf("[%lu] %s &\n", job->id, job->command);
+	else
+		printf("%s\n", job->command);
+	fflush(stdout);
+	if (job->state == JOB_STOPPED)
+		job->state = JOB_RUNNING;
+	kill(-job->pgid, SIGCONT);
+	if (*msh->sub_command[0] == 'b')
+		return (0);
+
+	if (interactive)
+		tcsetpgrp(STDIN_FILENO, job->pgid);
+	wait_job(msh, job);
+	if (interactive)
+		tcsetpgrp(STDIN_FILENO, getpgrp());
+
+	if (job->state == JOB_STOPPED)
+		return (print_job(msh, job), 128 + SIGTSTP);
+	exit_code = job->status;
+	remove_job(msh, job);
+
+	return (exit_code);
+}
+
+/**
+ * block_sigchld - blocks or restores the delivery of SIGCHLD
+ * @how: SIG_BLOCK to block SIGCHLD, or SIG_SETMASK to restore @old_mask
+ * @old_mask: where to save the previous mask (SIG_BLOCK), or the mask to
+ * restore (SIG_SETMASK)
+ *
+ * Description: The job table must not be changed while the SIGCHLD handler
+ * is walking it, so SIGCHLD is blocked around every change.
+ */
+void block_sigchld(int how, sigset_t *old_mask)
+{
+	sigset_t mask;
+
+	if (how == SIG_BLOCK)
+	{
+		sigemptyset(&mask);
+		sigaddset(&mask, SIGCHLD);
+		sigprocmask(SIG_BLOCK, &mask, old_mask);
+	}
+	else
+		sigprocmask(SIG_SETMASK, old_mask, NULL);
+}
@@ -0,0 +1,206 @@
+#include "shell.h"
+
+/* shorthands for the character classes, to keep the table readable */
+#define W CC_WORD
+#define B CC_BLANK
+#define S CC_SEMI
+#define A CC_AMP
+#define P CC_PIPE
+#define H CC_HASH
+#define E CC_END
+#define R CC_REDIR
+
+/* the class of every byte, indexed by its unsigned value */
+static const unsigned char char_class[256] = {
+	E, W, W, W, W, W, W, W, W, B, S, W, W, W, W, W,
+	W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W,
+	B, W, W, H, W, W, A, W, W, W, W, W, W, W, W, W,
+	W, W, W, W, W, W, W, W, W, W, W, S, R, W, R, W,
+	W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W,
+	W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W,
+	W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W,
+	W, W, W, W, W, W, W, W, W, W, W, W, P, W, W, W,
+	W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W,
+	W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W,
+	W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W,
+	W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W,
+	W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W,
+	W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W,
+	W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W,
+	W, W, W, W, W, W, W, W, W, W, W, W, W, W, W, W
+};
+
+#undef W
+#undef B
+#undef S
+#undef A
+#undef P
+#undef H
+#undef E
+#undef R
+
+/**
+ * add_token - appends a token to the token stream of a lexer
+ * @lexer: the lexer
+ * @offset: the offset of the token in the line
+ * @length: the length of the token
+ * @kind: the kind of token (one of the TOK_* macros)
+ *
+ * Return: 0 on success, else -1 on failure
+ */
+static int add_token(lexer_t *lexer, size_t offset, size_t length, int kind)
+{
+	token_t *tokens;
+	size_t size;
+
+	if (lexer->count == lexer->size)
+	{
+		size = (lexer->size == 0) ? 64 : lexer->size * 2;
+		tokens = _realloc(lexer->tokens, lexer->size * sizeof(token_t),
+				size * sizeof(token_t));
+		if (tokens == NULL)
+			return (-1);
+		lexer->tokens = tokens;
+		lexer->size = size;
+	}
+
+	lexer->tokens[lexer->count].offset = offset;
+	lexer->tokens[lexer->count].length = length;
+	lexer->tokens[lexer->count++].kind = kind;
+
+	return (0);
+}
+
+/**
+ * quoted_length - returns the length of a quoted string
+ * @quote: the opening quote
+ *
+ * Description: Inside double quotes, a backslash escapes the next character
+ * and ${...} expansions and $(...) command substitutions may hold quotes of
+ * their own. Inside single quotes,
+ * every character stands for itself.
+ *
+ * Return: the length of the quoted string, quotes included, else 0 if it
+ * isn't terminated
+ */
+static size_t quoted_length(const char *quote)
+{
+	size_t i, len;
+
+	for (i = 1; quote[i] != *quote; i++)
+	{
+		if (quote[i] == '\0')
+			return (0);
+		if (*quote == '"' && quote[i] == '\\' && quote[i + 1] != '\0')
+			i++;
+		else if (*quote == '"' && isbraced(quote + i) &&
+				(len = braced_length(quote + i)) > 0)
+			i += len - 1;
+	}
+
+	return (i + 1);
+}
+
+/**
+ * word_length - returns the length of the word starting a string
+ * @word: the start of the word
+ *
+ * Description: Quoted strings, ${...} expansions, $(...) command
+ * substitutions and characters escaped with a backslash are part of the word,
+ * blanks and operators included. '#' only starts a comment at the beginning
+ * of a word.
+ *
+ * Return: the length of the word, else 0 if a quoted string in it isn't
+ * terminated
+ */
+static size_t word_length(const char *word)
+{
+	size_t i = 0, len;
+	int class = CC_WORD;
+
+	while (class == CC_WORD || (class == CC_HASH && i > 0))
+	{
+		if (isquote(word[i]))
+		{
+			len = quoted_length(word + i);
+			if (len == 0)
+				return (0);
+			i += len;
+		}
+		else if (isbraced(word + i) &&
+				(len = braced_length(word + i)) > 0)
+			i += len; /* an unterminated one is a bad substitution later on */
+		else
+			i += (word[i] == '\\' && word[i + 1] != '\0') ? 2 : 1;
+		class = char_class[(unsigned char)word[i]];
+	}
+
+	return (i);
+}
+
+/**
+ * lex_line - splits a command line into a stream of tokens, in a single pass
+ * @lexer: the lexer, its token stream is reused from line to line
+ * @line: the command line
+ *
+ * Description: Tokens are (offset, length, kind) spans over @line, nothing is
+ * copied. Blanks separate words, newlines and ';' separate commands, and a
+ * comment runs from a '#' starting a word to the end of the line. Words keep
+ * their quotes, they are removed when the words are expanded. A redirection
+ * operator is a TOK_REDIR token, along with the file descriptor number
+ * written right before it. The stream always ends with a TOK_END token.
+ *
+ * Return: 0 on success, 1 if a quoted string isn't terminated, else -1 on
+ * failure
+ */
+int lex_line(lexer_t *lexer, const char *line)
+{
+	size_t i = 0, len;
+	int class, kind;
+
+	lexer->line = line;
+	lexer->count = lexer->pos = 0;
+
+	while ((class = char_class[(unsigned char)line[i]]) != CC_END)
+	{
+		if (class == CC_BLANK || class == CC_HASH)
+		{
+			do {
+				i++; /* a comment is skipped up to the newline */
+			} while (class == CC_HASH && line[i] != '\0' && line[i] != '\n');
+			continue;
+		}
+
+		if ((class == CC_REDIR || isdigit(line[i])) &&
+				(len = redir_length(line + i)) > 0)
+			kind = TOK_REDIR; /* with its file descriptor, e.g. 2> */
+		else if (class == CC_WORD && (len = word_length(line + i)) == 0)
+			return (1);
+		else if (class == CC_WORD)
+			kind = TOK_WORD;
+		else if (class == CC_SEMI)
+			kind = TOK_SEMI;
+		else if (class == CC_AMP)
+			kind = (line[i + 1] == '&') ? TOK_AND : TOK_AMP;
+		else
+			kind = (line[i + 1] == '|') ? TOK_OR : TOK_PIPE;
+		if (kind != TOK_WORD && kind != TOK_REDIR)
+			len = (kind == TOK_AND || kind == TOK_OR) ? 2 : 1;
+
+		if (add_token(lexer, i, len, kind) == -1)
+			return (-1);
+		i += len;
+	}
+
+	return (add_token(lexer, i, 0, TOK_END));
+}
+
+/**
+ * free_lexer - frees the token stream of a lexer
+ * @lexer: the lexer
+ */
+void free_lexer(lexer_t *lexer)
+{
+	safe_free(lexer->tokens);
+	lexer->count = lexer->size = lexer->pos = 0;
+}
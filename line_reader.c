@@ -0,0 +1,129 @@
+#include "shell.h"
+
+/**
+ * new_reader - creates a buffered line reader for a file descriptor
+ * @fd: the file descriptor to read from
+ *
+ * Return: the new reader, else NULL if memory allocation failed
+ */
+reader_t *new_reader(int fd)
+{
+	reader_t *reader = malloc(sizeof(reader_t));
+
+	if (reader == NULL)
+		return (NULL);
+
+	reader->buffer = malloc(READ_SIZE);
+	if (reader->buffer == NULL)
+	{
+		safe_free(reader);
+		return (NULL);
+	}
+	reader->fd = fd;
+	reader->size = READ_SIZE;
+	reader->start = reader->end = 0;
+
+	return (reader);
+}
+
+/**
+ * fill_reader - reads more data into a reader's buffer
+ * @reader: the reader
+ *
+ * Description: The bytes that were not handed out yet are moved to the start
+ * of the buffer first, the buffer only grows when a single line doesn't fit.
+ *
+ * Return: the number of bytes read, 0 at the end of the input, else -1 on
+ * error
+ */
+static ssize_t fill_reader(reader_t *reader)
+{
+	ssize_t n_read;
+	char *buffer;
+
+	if (reader->start > 0)
+	{
+		memmove(reader->buffer, reader->buffer + reader->start,
+				reader->end - reader->start);
+		reader->end -= reader->start;
+		reader->start = 0;
+	}
+	if (reader->end == reader->size)
+	{
+		buffer = _realloc(reader->buffer, reader->size, reader->size * 2);
+		if (buffer == NULL)
+			return (-1);
+		reader->buffer = buffer;
+		reader->size *= 2;
+	}
+
+	do {
+		n_read = read(reader->fd, reader->buffer + reader->end,
+				reader->size - reader->end);
+	} while (n_read == -1 && errno == EINTR);
+
+	if (n_read > 0)
+		reader->end += n_read;
+
+	return (n_read);
+}
+
+/**
+ * read_line - reads the next line from a reader
+ * @reader: the reader
+ * @lineptr: a pointer to the buffer to write the line to, it is (re)allocated
+ * as needed and can be reused for the next lines
+ * @n: a pointer to the size of the *@lineptr buffer
+ *
+ * Description: Whatever was read past the end of the line is kept for the
+ * next call, so the input is consumed one line at a time no matter how large
+ * it is. The line keeps its trailing newline, if any.
+ *
+ * Return: the number of bytes in the line, 0 at the end of the input, else -1
+ * on error
+ */
+ssize_t read_line(reader_t *reader, char **lineptr, size_t *n)
+{
+	char *newline;
+	size_t len;
+	ssize_t n_read = 1;
+
+	while ((newline = memchr(reader->buffer + reader->start, '\n',
+					reader->end - reader->start)) == NULL && n_read > 0)
+		n_read = fill_reader(reader);
+
+	if (n_read == -1)
+		return (-1);
+	len = (newline != NULL) ? (size_t)(newline - reader->buffer) + 1
+		: reader->end; /* the last line doesn't end with a newline */
+	len -= reader->start;
+	if (len == 0)
+		return (0);
+
+	if (*lineptr == NULL || *n < len + 1)
+	{
+		safe_free(*lineptr);
+		*lineptr = malloc(len + 1);
+		if (*lineptr == NULL)
+			return (-1);
+		*n = len + 1;
+	}
+	_memcpy(*lineptr, reader->buffer + reader->start, len);
+	(*lineptr)[len] = '\0';
+	reader->start += len;
+
+	return (len);
+}
+
+/**
+ * free_reader - frees a reader, the file descriptor is left open
+ * @reader: a pointer to the reader to free
+ */
+void free_reader(reader_t **reader)
+{
+	if (reader == NULL || *reader == NULL)
+		return;
+
+	safe_free((*reader)->buffer);
+	safe_free(*reader);
+}
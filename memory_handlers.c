@@ -51,7 +51,7 @@ void *_realloc(void *old_mem_blk, size_t old_size, size_t new_size)
 }
 
 /**
- * _memcpy - copy memory area
+ * memcpy_scalar - copy memory area
  * @dest: destination buffer
  * @src: source buffer
  * @n: number of bytes to write
@@ -61,7 +61,7 @@ void *_realloc(void *old_mem_blk, size_t old_size, size_t new_size)
  *
  * Return: A pointer to @dest
  */
-void *_memcpy(void *dest, const void *src, size_t n)
+void *memcpy_scalar(void *dest, const void *src, size_t n)
 {
 	size_t i;
 
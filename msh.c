@@ -13,37 +13,53 @@ int main(int argc, char *argv[])
 	ssize_t n_read = 0;
 	shell_t *msh = NULL;
 
+#ifdef MSH_ALLOC_STATS
+	atexit(print_alloc_stats);
+#endif
+	init_string_ops();
+
 	/* scout for singal interrupts (Ctrl + C) */
 	signal(SIGINT, sigint_handler);
 
 	msh = init_shell();
 	msh->prog_name = argv[0];
+	if (init_env() == -1)
+	{
+		fprintf(stderr, "%s: Not enough system memory to load the environment\n",
+				argv[0]);
+		return (-1);
+	}
 	build_path(&msh->path_list);
+	init_jobs(msh);
 
 	if (argc >= 2)
 	{
 		handle_file_as_input(argv[1], msh);
 	}
 
+	msh->input = get_reader(STDIN_FILENO);
 	while (RUNNING)
 	{
-		show_prompt();
-		fflush(stdout);
+		if (msh->interactive)
+		{
+			report_jobs(msh); /* let the user know about finished jobs */
+			show_prompt(msh);
+			fflush(stdout);
+		}
 
 		n_read = _getline(&msh->line, &len, STDIN_FILENO);
 
 		++msh->cmd_count; /* keep track of the number of inputs to the shell */
 
-		/* check for empty prompt or if Ctrl+D was received */
-		if (n_read == 0)
+		/* check for empty prompt, read errors or if Ctrl+D was received */
+		if (n_read <= 0)
 		{
-			if (isatty(STDIN_FILENO))
+			if (msh->interactive)
 				printf("exit\n");
 			handle_exit(msh, multi_free); /* clean up and leave */
 		}
 
-		msh->exit_code = parse_line(msh);
-		safe_free(msh->line);
+		msh->exit_code = parse_line(msh); /* the line buffer is reused */
 	}
 
 	return (msh->exit_code);
@@ -7,6 +7,7 @@
  */
 shell_t *init_shell(void)
 {
+	size_t i;
 	shell_t *msh = malloc(sizeof(shell_t));
 
 	if (msh == NULL)
@@ -17,14 +18,38 @@ shell_t *init_shell(void)
 	}
 
 	msh->path_list = NULL;
-	msh->aliases = NULL;
+	msh->aliases.buckets = NULL;
+	msh->aliases.first = msh->aliases.last = NULL;
+	msh->aliases.size = msh->aliases.count = 0;
+	msh->aliases.generation = msh->aliases.marks = 0;
 	msh->line = NULL;
 	msh->sub_command = NULL;
-	msh->commands = NULL;
-	msh->tokens = NULL;
-	msh->token = NULL;
+	msh->expansion.data = NULL;
+	msh->expansion.len = msh->expansion.size = 0;
+	msh->target.data = NULL;
+	msh->target.len = msh->target.size = 0;
+	msh->redirect.redirs = NULL;
+	msh->redirect.fds = NULL;
+	msh->redirect.count = 0;
+	msh->lexer.line = NULL;
+	msh->lexer.tokens = NULL;
+	msh->lexer.count = msh->lexer.size = msh->lexer.pos = 0;
+	msh->tree = NULL;
+	msh->arena.block = NULL;
 	msh->cmd_count = 0;
 	msh->exit_code = 0;
+	msh->interactive = isatty(STDIN_FILENO);
+	msh->jobs = NULL;
+	msh->async = 0;
+	msh->job_pgid = 0;
+	msh->job_command = NULL;
+	msh->cmd_text = NULL;
+	msh->last_bg_pid = 0;
+	msh->input = NULL;
+	msh->cache = NULL;
+
+	for (i = 0; i < HASH_SIZE; i++)
+		msh->cmd_table[i] = NULL;
 
 	return (msh);
 }
@@ -64,44 +89,6 @@ char *get_hostname(char *buffer)
 
 	return (buffer);
 }
-/**
- * show_prompt - shows the prompt in interactive mode
- */
-void show_prompt(void)
-{
-	char prompt[PROMPT_SIZE], hostname[100];
-	char *username = _getenv("USER"), *pwd;
-
-	if (username != NULL)
-	{
-		pwd = _getenv("PWD");
-		if (pwd != NULL)
-		{
-			/* get the right directory name to show on the prompt */
-			pwd = (*pwd == '/' && *(pwd + 1) == '\0')
-					  ? pwd
-					  : (_strrchr(pwd, '/') +
-						 1); /* show only the current directory */
-
-			sprintf(prompt, "[%s@%s %s]%% ", username, get_hostname(hostname),
-					(!_strcmp(pwd, username))
-						? "~" /* show '~' for the user's $HOME directory */
-						: pwd);
-		}
-	}
-	else
-	{
-		/*
-		 * there was not enough environment variables to build a much more
-		 * customized prompt, fall back to the minimal prompt
-		 */
-		sprintf(prompt, "msh%% ");
-	}
-
-	/* show the prompt in interactive modes only */
-	if (isatty(STDIN_FILENO))
-		printf("%s", prompt);
-}
 
 /**
  * sigint_handler - handles signal interrupts (Ctrl+C)
@@ -110,6 +97,25 @@ void show_prompt(void)
 void sigint_handler(__attribute__((unused))int signum)
 {
 	putchar('\n');
-	show_prompt();
+	show_prompt(NULL);
+	fflush(stdout);
+}
+
+/**
+ * print_error - reports an error of the current command on stderr
+ * @msh: contains all the data relevant to the shell's operation
+ * @format: the message, a printf() format without the "msh: 1: " prefix
+ *
+ * Description: The output still buffered on stdout is flushed first, so that
+ * it comes out before the error when both go to the same file.
+ */
+void print_error(shell_t *msh, const char *format, ...)
+{
+	va_list ap;
+
 	fflush(stdout);
+	fprintf(stderr, "%s: %lu: ", msh->prog_name, msh->cmd_count);
+	va_start(ap, format);
+	vfprintf(stderr, format, ap);
+	va_end(ap);
 }
@@ -78,3 +78,37 @@ int _atoi(const char *s)
 
 	return (num * sign);
 }
+
+/**
+ * hash_string - computes the djb2 hash of a string
+ * @str: the string to hash
+ *
+ * Return: the hash value of @str
+ */
+size_t hash_string(const char *str)
+{
+	size_t hash = 5381;
+
+	while (*str != '\0')
+		hash = ((hash << 5) + hash) + (unsigned char)*str++;
+
+	return (hash);
+}
+
+/**
+ * hash_bytes - computes the djb2 hash of a sequence of bytes
+ * @str: the bytes to hash, they don't need to be null-terminated
+ * @len: the number of bytes to hash
+ *
+ * Return: the hash value of the @len bytes of @str, the same as what
+ * hash_string() returns for the same string
+ */
+size_t hash_bytes(const char *str, size_t len)
+{
+	size_t i, hash = 5381;
+
+	for (i = 0; i < len; i++)
+		hash = ((hash << 5) + hash) + (unsigned char)str[i];
+
+	return (hash);
+}
@@ -0,0 +1,98 @@
+#include "shell.h"
+
+/**
+ * write_lines - writes an array of strings to a file descriptor, one string
+ * per line
+ * @fd: the file descriptor to write to
+ * @lines: a NULL-terminated array of strings
+ *
+ * Description: The strings are gathered into batches of I/O vectors and each
+ * batch is written with a single writev() call, so no intermediate buffer or
+ * copy is needed, and a few hundred lines cost a single system call.
+ *
+ * Return: 0 on success, else -1 on error
+ */
+int write_lines(int fd, char **lines)
+{
+	struct iovec iov[IOV_BATCH];
+	size_t count = 0;
+
+	fflush(stdout); /* anything printed before must come out first */
+	while (lines != NULL && *lines != NULL)
+	{
+		iov[count].iov_base = *lines;
+		iov[count++].iov_len = _strlen(*lines);
+		iov[count].iov_base = "\n";
+		iov[count++].iov_len = 1;
+		lines++;
+
+		if (count == IOV_BATCH || *lines == NULL)
+		{
+			if (writev_all(fd, iov, count) == -1)
+				return (-1);
+			count = 0;
+		}
+	}
+
+	return (0);
+}
+
+/**
+ * writev_all - writes all the data described by an array of I/O vectors
+ * @fd: the file descriptor to write to
+ * @iov: the I/O vectors, they are modified when a write is partial
+ * @count: the number of I/O vectors
+ *
+ * Return: 0 on success, else -1 on error
+ */
+int writev_all(int fd, struct iovec *iov, size_t count)
+{
+	ssize_t written;
+
+	while (count > 0)
+	{
+		written = writev(fd, iov, count);
+		if (written == -1)
+		{
+			if (errno == EINTR)
+				continue;
+			return (-1);
+		}
+
+		/* skip over what was written, and resume from there */
+		while (count > 0 && (size_t)written >= iov->iov_len)
+		{
+			written -= iov->iov_len;
+			iov++;
+			count--;
+		}
+		if (count > 0)
+		{
+			iov->iov_base = (char *)iov->iov_base + written;
+			iov->iov_len -= written;
+		}
+	}
+
+	return (0);
+}
+
+/**
+ * move_fd - moves a file descriptor of the shell to SHELL_FD_MIN or above,
+ * out of the way of the ones redirections target, and makes it close-on-exec
+ * @fd: the file descriptor, -1 is passed through
+ *
+ * Return: the new file descriptor, else -1 on failure, in which case @fd is
+ * closed as well
+ */
+int move_fd(int fd)
+{
+	int moved;
+
+	if (fd == -1 || fd >= SHELL_FD_MIN)
+		return (fd);
+
+	moved = fcntl(fd, F_DUPFD_CLOEXEC, SHELL_FD_MIN);
+	close(fd);
+
+	return (moved);
+}
@@ -0,0 +1,135 @@
+#include "shell.h"
+
+/**
+ * parallel_jobs - parses the options of the parallel builtin,
+ * `[-j N] [--]`
+ * @msh: contains all the data relevant to the shell's operation
+ * @jobs: where to store the largest number of commands running at once, one
+ * per online CPU unless -j says otherwise
+ *
+ * Return: the index of the first command line in msh->sub_command, else 0 if
+ * the number of jobs is invalid, which is reported
+ */
+static size_t parallel_jobs(shell_t *msh, size_t *jobs)
+{
+	char **args = msh->sub_command;
+	const char *value = NULL;
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	size_t i = 1;
+
+	*jobs = (cpus > 0) ? (size_t)cpus : 1;
+	if (args[1] != NULL && !_strncmp(args[1], "-j", 2))
+	{
+		value = (args[1][2] != '\0') ? args[1] + 2 : args[2];
+		i = (args[1][2] != '\0' || value == NULL) ? 2 : 3;
+		if (value == NULL || *value == '\0' || _strlen(value) > 9 ||
+				value[_strspn(value, "0123456789")] != '\0' ||
+				_atoi(value) < 1 || _atoi(value) > PARALLEL_MAX_JOBS)
+		{
+			print_error(msh, "parallel: Illegal number: %s\n",
+					(value == NULL) ? "" : value);
+			return (0);
+		}
+		*jobs = _atoi(value);
+	}
+	if (args[i] != NULL && !_strcmp(args[i], "--"))
+		i++;
+
+	return (i);
+}
+
+/**
+ * read_commands - runs the command lines the parallel builtin reads from its
+ * standard input, one per line
+ * @par: the state of the builtin
+ *
+ * Description: When the shell reads its own commands from the standard
+ * input, the lines are taken from the shell's reader, so the shell carries on
+ * right after them; any other input gets a reader of its own. The commands
+ * read from /dev/null, so that they can't eat the lines meant for the
+ * builtin.
+ */
+static void read_commands(parallel_t *par)
+{
+	shell_t *msh = par->msh;
+	reader_t *reader = msh->input;
+	redir_t *redir = msh->redirect.redirs;
+	char *line = NULL;
+	size_t n = 0, i;
+	ssize_t len = 0;
+
+	for (i = 0; i < msh->redirect.count; i++, redir = redir->next)
+		if (redir->fd == STDIN_FILENO)
+			reader = NULL; /* the builtin's input isn't the shell's */
+	if (reader == NULL || reader->fd != STDIN_FILENO)
+		reader = new_reader(STDIN_FILENO);
+	par->in_fd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+	if (par->in_fd == -1)
+		par->in_fd = STDIN_FILENO;
+
+	while (reader != NULL && (len = read_line(reader, &line, &n)) > 0)
+	{
+		if (reader == msh->input)
+			++msh->cmd_count; /* errors are reported with the line number */
+		if (line[len - 1] == '\n')
+			line[len - 1] = '\0';
+		start_parallel(par, line);
+	}
+	if (reader == NULL || len == -1)
+		perror("parallel");
+	safe_free(line);
+	if (reader != msh->input)
+		free_reader(&reader);
+	if (par->in_fd != STDIN_FILENO)
+		close(par->in_fd);
+}
+
+/**
+ * handle_parallel - handles the builtin `parallel` command, which runs
+ * command lines at the same time, `parallel [-j N] [command ...]`
+ * @msh: contains all the data relevant to the shell's operation
+ *
+ * Description: Every argument is a command line, else they are read from the
+ * standard input. At most N of them run at once, one per online CPU by
+ * default, and the next one starts as soon as one terminates. The lines are
+ * parsed and expanded in an arena and a buffer of their own, so the
+ * arguments of the builtin are left alone and the memory of a line is reused
+ * by the next one.
+ *
+ * Return: 0 if every command succeeded, 1 if any failed, else 2 on an
+ * invalid number of jobs
+ */
+int handle_parallel(shell_t *msh)
+{
+	buffer_t words = msh->expansion;
+	arena_t arena = msh->arena;
+	char **args = msh->sub_command;
+	parallel_t par = {NULL, NULL, 0, 0, 0, STDIN_FILENO};
+	size_t i = parallel_jobs(msh, &par.jobs);
+
+	if (i == 0)
+		return (CMD_ERR);
+	par.msh = msh;
+	par.pids = malloc(sizeof(pid_t) * par.jobs);
+	if (par.pids == NULL)
+		return (perror("parallel"), 1);
+
+	msh->expansion.data = NULL;
+	msh->expansion.len = msh->expansion.size = 0;
+	msh->arena.block = NULL;
+	if (args[i] == NULL)
+		read_commands(&par);
+	for (; args[i] != NULL; i++)
+		start_parallel(&par, args[i]);
+	while (par.running > 0)
+		reap_parallel(&par);
+
+	free_arena(&msh->arena);
+	safe_free(msh->expansion.data);
+	msh->arena = arena;
+	msh->expansion = words;
+	msh->sub_command = args;
+	safe_free(par.pids);
+
+	return (par.failed > 0);
+}
@@ -0,0 +1,114 @@
+#include "shell.h"
+
+/**
+ * fork_command - runs a command tree of the parallel builtin in a forked
+ * copy of the shell, without waiting for it
+ * @par: the state of the builtin
+ * @tree: the command tree
+ *
+ * Description: The copy stays in the process group of the shell, see
+ * reap_parallel().
+ *
+ * Return: the process ID of the forked shell, else -1 if forking failed
+ */
+static pid_t fork_command(parallel_t *par, node_t *tree)
+{
+	shell_t *msh = par->msh;
+	pid_t pid;
+
+	fflush(stdout); /* don't let the child inherit our pending output */
+	pid = fork();
+	if (pid == -1)
+		perror("fork");
+	if (pid != 0)
+		return (pid);
+
+	reset_child_signals(msh);
+	if (par->in_fd != STDIN_FILENO)
+	{
+		dup2(par->in_fd, STDIN_FILENO);
+		close(par->in_fd);
+		msh->input = NULL; /* the shell's input isn't on fd 0 anymore */
+	}
+	execute_tree(msh, tree);
+
+	fflush(stdout);
+	_exit(msh->exit_code);
+}
+
+/**
+ * start_parallel - starts a command line of the parallel builtin without
+ * waiting for it, once fewer than the allowed number of commands are running
+ * @par: the state of the builtin
+ * @line: the command line, its words are null-terminated in place
+ *
+ * Description: A simple command starts like a stage of a pipeline, so
+ * external programs are spawned directly and builtins run in a forked copy of
+ * the shell. Lists and pipelines run in a forked copy of the shell too.
+ * Everything the line needed is given back as soon as it is started.
+ */
+void start_parallel(parallel_t *par, char *line)
+{
+	shell_t *msh = par->msh;
+	node_t *tree;
+	pid_t pid = 0;
+
+	if (par->running == par->jobs)
+		reap_parallel(par);
+	if (build_tree(&msh->lexer, &msh->arena, line, &tree) != 0)
+	{
+		print_error(msh, "parallel: Syntax error: %s\n", line);
+		pid = -CMD_ERR;
+	}
+	else if (tree != NULL && tree->type == NODE_CMD)
+		pid = start_stage(msh, tree, par->in_fd, STDOUT_FILENO);
+	else if (tree != NULL)
+		pid = fork_command(par, tree);
+	arena_reset(&msh->arena);
+
+	if (pid > 0)
+		par->pids[par->running++] = pid;
+	else if (pid < 0)
+		par->failed++;
+}
+
+/**
+ * reap_parallel - waits for one of the commands started by the parallel
+ * builtin to terminate
+ * @par: the state of the builtin
+ *
+ * Description: The commands run in the process group of the shell, while
+ * background jobs have process groups of their own, so waiting for any child
+ * of that group never takes a process away from the job table. The resources
+ * the command used are counted for the `time` keyword.
+ */
+void reap_parallel(parallel_t *par)
+{
+	struct rusage usage;
+	size_t i;
+	pid_t pid;
+	int status;
+
+	while (par->running > 0)
+	{
+		pid = wait4(0, &status, 0, &usage);
+		if (pid == -1 && errno == EINTR)
+			continue;
+		if (pid == -1)
+		{
+			perror("wait");
+			par->failed += par->running;
+			par->running = 0;
+			return;
+		}
+		add_child_usage(&usage);
+		for (i = 0; i < par->running && par->pids[i] != pid; i++)
+			;
+		if (i == par->running)
+			continue; /* not one of ours */
+		par->pids[i] = par->pids[--par->running];
+		if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+			par->failed++;
+		return;
+	}
+}
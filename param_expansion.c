@@ -0,0 +1,205 @@
+#include "shell.h"
+
+/**
+ * match_length - finds the part of a value a pattern trims off
+ * @value: the value, it is modified while matching but restored
+ * @len: the length of the value
+ * @pattern: the pattern
+ * @prefix: true to match a prefix of the value (#), else a suffix (%)
+ * @longest: true to match the longest part (## and %%), else the shortest
+ *
+ * Return: the length of the matching prefix, or the offset of the matching
+ * suffix, else 0 or @len when nothing matches
+ */
+static size_t match_length(char *value, size_t len, const char *pattern,
+		int prefix, int longest)
+{
+	size_t i, at;
+	char c;
+	int match;
+
+	for (i = 0; i <= len; i++)
+	{
+		at = (prefix != longest) ? i : len - i;
+		if (prefix)
+		{
+			c = value[at];
+			value[at] = '\0';
+			match = !fnmatch(pattern, value, 0);
+			value[at] = c;
+		}
+		else
+			match = !fnmatch(pattern, value + at, 0);
+		if (match)
+			return (at);
+	}
+
+	return ((prefix) ? 0 : len);
+}
+
+/**
+ * trim_value - expands ${name#word}, ${name##word}, ${name%word} and
+ * ${name%%word}, the value without the shortest or longest prefix or suffix
+ * matching the pattern word
+ * @msh: shell data
+ * @value: the value of the parameter, NULL if it isn't set
+ * @op: the operator in the expansion
+ * @quoted: set to 1 if the word has quotes, see expand_text()
+ *
+ * Description: The value and the pattern are written to msh->expansion, the
+ * trimmed value is then moved in place of them.
+ *
+ * Return: a pointer past the expansion, else NULL on failure
+ */
+static const char *trim_value(shell_t *msh, const char *value, const char *op,
+		int *quoted)
+{
+	buffer_t *buf = &msh->expansion;
+	size_t start = buf->len, len = (value) ? _strlen(value) : 0, pattern, at;
+	int longest = (op[1] == *op), prefix = (*op == '#');
+	const char *end;
+
+	if (buffer_write(buf, (value) ? value : "", len) == -1 ||
+			buffer_putc(buf, '\0') == -1)
+		return (NULL);
+	pattern = buf->len;
+	end = expand_text(msh, op + 1 + longest, '}', quoted, 1);
+	if (end == NULL || buffer_putc(buf, '\0') == -1)
+		return (NULL);
+
+	at = match_length(buf->data + start, len, buf->data + pattern, prefix,
+			longest);
+	if (prefix)
+	{
+		memmove(buf->data + start, buf->data + start + at, len - at);
+		buf->len = start + len - at;
+	}
+	else
+		buf->len = start + at;
+
+	return (end + 1);
+}
+
+/**
+ * use_default - expands ${name-word}, ${name=word} and ${name+word}, and
+ * their ':' forms which treat an empty value like an unset one
+ * @msh: shell data
+ * @name: the name of the parameter
+ * @op: the operator in the expansion
+ * @value: the value of the parameter, NULL if it isn't set
+ * @quoted: set to 1 if the word has quotes, see expand_text()
+ *
+ * Description: '-' stands for the word when the parameter is unset, '='
+ * also assigns it to the parameter, and '+' stands for the word when the
+ * parameter is set. The word is only expanded when it is used.
+ *
+ * Return: a pointer past the expansion, else NULL on failure
+ */
+static const char *use_default(shell_t *msh, const char *name, const char *op,
+		const char *value, int *quoted)
+{
+	size_t start = msh->expansion.len, len = op - name;
+	int set = (value != NULL && (*op != ':' || *value != '\0'));
+	const char *end;
+
+	op += (*op == ':');
+	if (*op != '-' && *op != '=' && *op != '+')
+		return (NULL);
+	if ((*op == '+') != set)
+	{
+		if (*op != '+' && value != NULL &&
+				buffer_write(&msh->expansion, value, _strlen(value)) == -1)
+			return (NULL);
+		len = braced_length(name - 2); /* skip the word */
+		return ((len == 0) ? NULL : name - 2 + len);
+	}
+
+	end = expand_text(msh, op + 1, '}', quoted, 0);
+	if (end == NULL || *op != '=')
+		return ((end == NULL) ? NULL : end + 1);
+	if (!isalpha(*name) && *name != '_')
+		return (NULL); /* special parameters can't be assigned */
+	if (buffer_putc(&msh->expansion, '\0') == -1)
+		return (NULL);
+	msh->expansion.len--;
+	name = arena_strndup(&msh->arena, name, len);
+	if (name == NULL ||
+			_setenv(msh, name, msh->expansion.data + start, 1) != 0)
+		return (NULL);
+
+	return (end + 1);
+}
+
+/**
+ * expand_braced - expands a ${...} parameter expansion
+ * @msh: shell data
+ * @name: the text right after the '{'
+ * @quoted: set to 1 if the word of the expansion has quotes
+ *
+ * Description: ${name} is the value of the parameter, ${#name} its length,
+ * the other forms are handled by use_default() and trim_value().
+ *
+ * Return: a pointer past the expansion, else NULL on a bad substitution or
+ * if memory allocation failed
+ */
+static const char *expand_braced(shell_t *msh, const char *name, int *quoted)
+{
+	const char *value, *op;
+	char buffer[32];
+	int length = (*name == '#' && name[1] != '}');
+	size_t len;
+
+	len = get_param(msh, name + length, &value, buffer);
+	op = name + length + len;
+	if (len == 0 || (length && *op != '}'))
+		return (NULL);
+
+	if (*op == '}')
+	{
+		if (length)
+		{
+			_itoa((value) ? _strlen(value) : 0, buffer);
+			value = buffer;
+		}
+		if (value != NULL &&
+				buffer_write(&msh->expansion, value, _strlen(value)) == -1)
+			return (NULL);
+		return (op + 1);
+	}
+	if (*op == '#' || *op == '%')
+		return (trim_value(msh, value, op, quoted));
+
+	return (use_default(msh, name, op, value, quoted));
+}
+
+/**
+ * expand_param - expands the parameter following a '$', appending its value
+ * to msh->expansion
+ * @msh: shell data
+ * @param: the text right after the '$'
+ * @quoted: set to 1 if the word of a ${...} expansion has quotes
+ *
+ * Description: A $(...) command substitution is expanded to the output of
+ * the command, see substitute_command().
+ *
+ * Return: a pointer past the parameter, @param if there is none (the '$'
+ * then stands for itself), else NULL on a bad substitution or on failure
+ */
+const char *expand_param(shell_t *msh, const char *param, int *quoted)
+{
+	const char *value;
+	char buffer[32];
+	size_t len;
+
+	if (*param == '{')
+		return (expand_braced(msh, param + 1, quoted));
+	if (*param == '(')
+		return (substitute_command(msh, param - 1));
+
+	len = get_param(msh, param, &value, buffer);
+	if (len > 0 && value != NULL &&
+			buffer_write(&msh->expansion, value, _strlen(value)) == -1)
+		return (NULL);
+
+	return (param + len);
+}
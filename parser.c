@@ -1,193 +1,170 @@
 #include "shell.h"
 
 /**
- * parse_line - parses the receive command line, processes it before handing it
- * over to the executor only after it has confirmed the command is valid
+ * parse_line - parses the received command line and executes it
  * @msh: contains all the data relevant to the shell's operation
  *
+ * Description: Everything the line needed is given back at once afterwards,
+ * by resetting the shell's arena.
+ *
  * Return: the exit code of the executed program, else -1 if something goes
  * wrong
  */
 int parse_line(shell_t *msh)
 {
-	size_t i;
-
-	/* skip normal ENTER keys and leading comments */
-	if (*msh->line == '\n' || *msh->line == '#')
-		return (0);
-
-	/* first of all, let's get rid of all comments */
-	msh->line = handle_comments(msh->line);
+	int status = compile_line(msh);
 
-	msh->tokens = _strtok(msh->line, "\n");
-	if (msh->tokens == NULL)
-	{
-		fprintf(stderr, "Not enough system memory to continue\n");
-		return (-1);
-	}
-
-	for (i = 0; msh->tokens[i] != NULL; i++)
-	{
-		msh->token = msh->tokens[i];
-
-		if (!_strcmp(msh->tokens[i], "exit") && msh->tokens[i + 1] == NULL)
-		{
-			handle_exit(msh, multi_free);
-		}
+	if (status == 0 && msh->tree != NULL)
+		execute_tree(msh, msh->tree);
+	msh->tree = NULL;
+	arena_reset(&msh->arena);
+	buffer_trim(&msh->expansion);
+	buffer_trim(&msh->target);
 
-		/* now let's tokenize all the commands provided by the user */
-		msh->commands = _strtok(msh->token, ";\n");
-		if (msh->commands == NULL)
-		{
-			fprintf(stderr, "Memory allocation failed...\n");
-			return (-1);
-		}
-
-		msh->exit_code = parse(msh);
-		free_str(&msh->commands);
-	}
-
-	free_str(&msh->tokens);
-	return (msh->exit_code);
+	return ((status == -1) ? -1 : msh->exit_code);
 }
 
 /**
- * parse - parses an array of commands received from the prompt
+ * syntax_error - reports a syntax error of the received command line
  * @msh: contains all the data relevant to the shell's operation
- *
- * Return: the exit code of the executed program
+ * @status: 1 for an unterminated quote, 2 for a misplaced or missing token,
+ * with msh->lexer positioned at the unexpected token
  */
-int parse(shell_t *msh)
+static void syntax_error(shell_t *msh, int status)
 {
-	ssize_t i, offset;
-	char *cur_cmd = NULL, *operator = NULL;
-	char *next_cmd = NULL, *temp_next_cmd = NULL;
+	token_t *token = &msh->lexer.tokens[msh->lexer.pos];
+	const char *text = msh->lexer.line + token->offset;
 
-	for (i = 0; msh->commands[i] != NULL; i++)
-	{
-		operator = get_operator(msh->commands[i]);
-		if (operator != NULL)
-		{
-			offset = strcspn(msh->commands[i], operator);
-			/* extract the command before the operator */
-			cur_cmd = strndup(msh->commands[i], offset);
-			if (cur_cmd == NULL)
-				return (0);
-			msh->sub_command = _strtok(cur_cmd, NULL);
-			safe_free(cur_cmd);
-			if (msh->sub_command == NULL)
-				return (0);
-			msh->sub_command = handle_variables(msh);
-			parse_helper(msh, i);
-
-			temp_next_cmd = _strdup(&msh->commands[i][offset + 2]);
-			safe_free(next_cmd);
-			safe_free(msh->commands[i]);
-
-			/* check the exit code and react accordingly */
-			if ((!_strcmp(operator, "&&") && msh->exit_code == 0) ||
-				(!_strcmp(operator, "||") && msh->exit_code != 0))
-			{
-				msh->commands[i] = temp_next_cmd;
-				parse(msh);
-				next_cmd = temp_next_cmd;
-			}
-			else
-				safe_free(temp_next_cmd);
-		}
-		else
-			parse_and_execute(msh, i);
-	}
-	return (msh->exit_code);
+	if (status == 1)
+		print_error(msh, "Syntax error: Unterminated quoted string\n");
+	else if (token->kind == TOK_END || *text == '\n')
+		print_error(msh, "Syntax error: newline unexpected\n");
+	else
+		print_error(msh, "Syntax error: \"%.*s\" unexpected\n",
+				(int)token->length, text);
+	msh->exit_code = CMD_ERR;
+	if (msh->cache != NULL)
+		msh->cache->failed = 1; /* the error must show up on every run */
 }
 
 /**
- * parse_and_execute - parses each sub command line and executes it
+ * compile_line - turns the received command line into a command tree
  * @msh: contains all the data relevant to the shell's operation
- * @index: the current index in commands array
  *
- * Return: the exit code of the executed program
+ * Description: The tree is stored in msh->tree, which is left NULL for lines
+ * with no commands or with a syntax error, and is allocated from msh->arena.
+ * The bodies of its here-documents are read right after the line. When a
+ * script is being compiled, the tree is also added to its cache along with
+ * the line number.
+ *
+ * Return: 0 on success, else -1 on failure
  */
-int parse_and_execute(shell_t *msh, size_t index)
+int compile_line(shell_t *msh)
 {
-	/* get the sub commands and work on them */
-	msh->sub_command = _strtok(msh->commands[index], NULL);
-	if (msh->sub_command == NULL)
+	int status = build_tree(&msh->lexer, &msh->arena, msh->line, &msh->tree);
+
+	if (status == 0 && msh->tree != NULL)
+		status = read_heredocs(msh, msh->tree);
+	if (status == -1)
 	{
-		return (0); /* probably just lots of tabs or spaces, maybe both */
+		fprintf(stderr, "Not enough system memory to continue\n");
+		return (-1);
 	}
+	if (status != 0)
+		syntax_error(msh, status);
 
-	/* check for variables */
-	msh->sub_command = handle_variables(msh);
-	if (msh->sub_command[0] != NULL && msh->sub_command != NULL)
-		parse_helper(msh, index);
-	else
-		free_str(&msh->sub_command);
+	if (msh->cache != NULL && msh->cache->fd != -1 && msh->tree != NULL)
+	{
+		put_number(msh->cache, msh->cmd_count);
+		put_node(msh->cache, msh->tree);
+		if (msh->cache->len >= READ_SIZE)
+			put_block(msh->cache); /* blocks only hold whole lines */
+	}
 
-	/* cleanup and leave */
-	safe_free(msh->commands[index]);
-	return (msh->exit_code);
+	return (0);
 }
 
 /**
- * parse_helper - performs extra parsing on behalf of the parse and execute
- * function
- * @msh: contains all the data relevant to the shell's operation
- * @index: the current index in commands array
+ * build_tree - builds the command tree of a command line
+ * @lexer: the lexer to split the line into tokens with
+ * @arena: the arena to allocate the tree from
+ * @line: the command line, its words are null-terminated in place
+ * @tree: where to store the root of the tree, NULL if there are no commands
+ *
+ * Description: The words of the tree are slices of @line, so @line must
+ * outlive the tree.
+ *
+ * Return: 0 on success, 1 on an unterminated quote, 2 on a syntax error, see
+ * check_syntax(), else -1 on failure
  */
-void parse_helper(shell_t *msh, size_t index)
+int build_tree(lexer_t *lexer, arena_t *arena, char *line, node_t **tree)
 {
-	char *alias_value;
+	node_t **tail = tree, *node;
+	size_t i;
+	int status;
 
-	if (!_strcmp(msh->sub_command[0], "alias") ||
-			!_strcmp(msh->sub_command[0], "unalias"))
+	*tree = NULL;
+	status = lex_line(lexer, line);
+	if (status == 0)
+		status = check_syntax(lexer);
+	while (status == 0 && lexer->tokens[lexer->pos].kind != TOK_END)
 	{
-		msh->exit_code = handle_alias(&msh->aliases, msh->commands[index]);
-		free_str(&msh->sub_command);
-		return;
-	}
+		if (lexer->tokens[lexer->pos].kind == TOK_SEMI)
+		{
+			lexer->pos++; /* skip empty commands */
+			continue;
+		}
 
-	alias_value = get_alias(msh->aliases, msh->sub_command[0]);
-	if (alias_value != NULL)
-	{
-		build_alias_cmd(&msh->sub_command, alias_value);
-		safe_free(alias_value);
+		node = build_command(lexer, arena);
+		if (node != NULL && *tail != NULL)
+			node = new_node(arena, NODE_SEQ, *tail, node);
+		if (node == NULL)
+			status = -1;
+		/* the first command ends up on top, the rest of the line on its right */
+		else if ((*tail = node)->type == NODE_SEQ)
+			tail = &node->right;
 	}
+	if (status != 0)
+		*tree = NULL;
 
-	msh->exit_code = handle_builtin(msh);
-	if (msh->exit_code != NOT_BUILTIN)
-	{
-		free_str(&msh->sub_command);
-		return; /* shell builtin executed well */
-	}
-	/* handle the command with the PATH variable */
-	if (msh->path_list != NULL && !_strchr(msh->sub_command[0], '/'))
-	{
-		msh->exit_code = handle_with_path(msh);
-		if (msh->exit_code == -1)
-			msh->exit_code = print_cmd_not_found(msh);
-	}
-	else
-	{
-		if (access(msh->sub_command[0], X_OK) == 0 &&
-				_strchr(msh->sub_command[0], '/'))
-			msh->exit_code = execute_command(msh->sub_command[0], msh);
-		else
-			msh->exit_code = print_cmd_not_found(msh);
-	}
-	free_str(&msh->sub_command);
+	/* the tokens are no longer needed, the words can be cut out of the line */
+	for (i = 0; status == 0 && i < lexer->count; i++)
+		if (lexer->tokens[i].kind == TOK_WORD)
+			line[lexer->tokens[i].offset + lexer->tokens[i].length] = '\0';
+
+	return (status);
 }
 
 /**
- * print_cmd_not_found - prints the command not found error
- * @msh: contains all the data relevant to the shell's operation
+ * build_command - builds the tree of a single command of a command line
+ * @lexer: the token stream, positioned at the start of the command
+ * @arena: the arena to allocate the tree from
+ *
+ * Description: A command ends at a ';', a newline or the background operator
+ * '&', which puts the command under a NODE_ASYNC node.
  *
- * Return: 127 command not found code, else 0
+ * Return: the root of the tree, else NULL on failure
  */
-int print_cmd_not_found(shell_t *msh)
+node_t *build_command(lexer_t *lexer, arena_t *arena)
 {
-	dprintf(STDERR_FILENO, "%s: %lu: %s: not found\n", msh->prog_name,
-			msh->cmd_count, msh->sub_command[0]);
-
-	return (CMD_NOT_FOUND); /* command not found */
+	token_t *first = &lexer->tokens[lexer->pos], *end;
+	node_t *tree = build_and_or(lexer, arena);
+
+	if (tree == NULL)
+		return (NULL);
+
+	end = &lexer->tokens[lexer->pos];
+	if (end->kind == TOK_SEMI || end->kind == TOK_AMP)
+		lexer->pos++;
+	if (end->kind != TOK_AMP)
+		return (tree);
+
+	tree = new_node(arena, NODE_ASYNC, tree, NULL);
+	if (tree == NULL)
+		return (NULL);
+	/* name the job after the command, from its first to its last token */
+	tree->text = arena_strndup(arena, lexer->line + first->offset,
+			(end == first) ? 0 : end[-1].offset + end[-1].length - first->offset);
+
+	return ((tree->text == NULL) ? NULL : tree);
 }
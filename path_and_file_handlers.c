@@ -1,48 +1,123 @@
 #include "shell.h"
 
 /**
- * handle_with_path - handles commands when the PATH is set
+ * handle_with_path - handles commands found in the PATH or given as a path
  * @msh: contains all the data relevant to the shell's operation
  *
+ * Description: The location of a command is remembered the first time it is
+ * found in the PATH, so running it again skips the PATH search entirely.
+ *
  * Return: the exit code of the child process, else -1 if the command is not in
  * the PATH provided
  */
 int handle_with_path(shell_t *msh)
 {
 	char path[BUFF_SIZE];
-	path_t *path_list = msh->path_list;
 
-	while (path_list != NULL)
+	if (find_command(msh, msh->sub_command[0], path) == -1)
+		return (-1);
+
+	return (execute_command(path, msh));
+}
+
+/**
+ * find_command - finds the executable file of a command
+ * @msh: contains all the data relevant to the shell's operation
+ * @name: the name of the command, or a path to it
+ * @path: the buffer to write the full path of the command to, it should be
+ * at least BUFF_SIZE bytes large
+ *
+ * Description: Names containing a '/' are used as-is, any other name is
+ * searched in the PATH unless its location was remembered before.
+ *
+ * Return: 0 if the command was found, else -1
+ */
+int find_command(shell_t *msh, const char *name, char *path)
+{
+	char *remembered;
+	cmd_hash_t *remembered_node;
+
+	if (_strchr(name, '/') != NULL)
+	{
+		if (access(name, X_OK) == -1 || _strlen(name) >= BUFF_SIZE)
+			return (-1);
+		_strcpy(path, name);
+		return (0);
+	}
+
+	remembered = hash_lookup(msh, name);
+	if (remembered != NULL)
+		return (_strcpy(path, remembered), 0);
+
+	if (search_path(msh->path_list, name, path) == -1)
+		return (-1);
+
+	remembered_node = hash_insert(msh, name, path);
+	if (remembered_node != NULL)
+		remembered_node->hits++; /* this search counts as the first use */
+	return (0);
+}
+
+/**
+ * search_path - searches the PATH directories for an executable command
+ * @path_list: the list of the PATH directories
+ * @name: the name of the command to search for
+ * @path: the buffer to write the full path of the command to, it should be
+ * at least BUFF_SIZE bytes large
+ *
+ * Description: Directories where the full path doesn't fit in @path are
+ * skipped.
+ *
+ * Return: 0 if the command was found, else -1
+ */
+int search_path(path_t *path_list, const char *name, char *path)
+{
+	int len;
+
+	for (; path_list != NULL; path_list = path_list->next)
 	{
-		sprintf(path, "%s%s%s", path_list->pathname, "/", msh->sub_command[0]);
+		len = snprintf(path, BUFF_SIZE, "%s/%s", path_list->pathname, name);
+		if (len < 0 || len >= BUFF_SIZE)
+			continue; /* truncated, it isn't the path of the command */
 		if (access(path, X_OK) == 0)
-		{
-			return (execute_command(path, msh));
-		}
-		else if (access(msh->sub_command[0], X_OK) == 0)
-		{
-			return (execute_command(path, msh));
-		}
-		path_list = path_list->next;
+			return (0);
 	}
 
 	return (-1);
 }
 
+/**
+ * refresh_path - rebuilds the list of PATH directories after PATH changed
+ * @msh: contains all the data relevant to the shell's operation
+ *
+ * Description: The remembered command locations are forgotten as well since
+ * they may no longer be what a PATH search would find.
+ */
+void refresh_path(shell_t *msh)
+{
+	free_list(&msh->path_list);
+	build_path(&msh->path_list);
+	hash_reset(msh);
+}
+
 /**
  * handle_file_as_input - handles execution when a file is given as input on
  * the command line (non-interactive mode)
  * @filename: the name of the file to read from
  * @msh: contains all the data relevant to the shell's operation
  *
+ * Description: The script is executed one line at a time while it is being
+ * read, so commands start right away and memory use doesn't depend on the
+ * size of the script. Its command trees are saved to a cache next to it, so
+ * later runs of the unchanged script skip reading and parsing it.
+ *
  * Return: 0, or the exit status of the just exited process
  */
 void handle_file_as_input(const char *filename, shell_t *msh)
 {
-	size_t n = 0;
-	int n_read, fd;
+	int fd;
 
-	fd = open(filename, O_RDONLY);
+	fd = move_fd(open(filename, O_RDONLY | O_CLOEXEC));
 	if (fd == -1)
 	{
 		/* we couldn't open the file, let's clean and leave */
@@ -50,8 +125,14 @@ void handle_file_as_input(const char *filename, shell_t *msh)
 		fprintf(stderr, "%s: 0: Can't open %s\n", msh->prog_name, filename);
 		exit(CMD_NOT_FOUND);
 	}
+	msh->prog_name = filename;
 
-	n_read = _getline(&msh->line, &n, fd);
+	/* scripts that ran before are run from their compiled cache */
+	msh->cache = load_cache(filename, fd);
+	if (msh->cache != NULL)
+		run_cache(msh, filename);
+	else
+		run_script(msh, filename, fd, 0);
 
 	/*
 	 * let us know if there was an error while closing file descriptor but
@@ -60,17 +141,5 @@ void handle_file_as_input(const char *filename, shell_t *msh)
 	if (close(fd) == -1)
 		fprintf(stderr, "An error occurred while closing file descriptor #%d\n", fd);
 
-	if (n_read == -1)
-	{
-		msh->exit_code = -1;
-		handle_exit(msh, multi_free);
-	}
-
-	if (n_read)
-	{
-		msh->prog_name = filename;
-		parse_line(msh);
-	}
-
 	handle_exit(msh, multi_free);
 }
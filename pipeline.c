@@ -0,0 +1,218 @@
+#include "shell.h"
+
+/**
+ * execute_pipeline - executes a pipeline of commands (cmd1 | cmd2 | ...)
+ * @msh: contains all the data relevant to the shell's operation
+ * @pipeline: the tree of the pipeline
+ *
+ * Description: Every stage of the pipeline is started before any is waited
+ * on, with each stage's standard output connected to the next one's standard
+ * input. Background pipelines are added to the job table instead, with all
+ * their stages in the process group of the first one.
+ *
+ * Return: the exit code of the last stage of the pipeline
+ */
+int execute_pipeline(shell_t *msh, node_t *pipeline)
+{
+	node_t *stage;
+	size_t i, count = 1;
+	int fds[2], in_fd = STDIN_FILENO, out_fd;
+	pid_t *pids;
+
+	for (stage = pipeline; stage->type == NODE_PIPE; stage = stage->right)
+		count++;
+	msh->job_pgid = 0;
+	pids = arena_alloc(&msh->arena, sizeof(pid_t) * (count + 1));
+	if (pids == NULL)
+		return (-1);
+
+	for (i = 0, stage = pipeline; i < count; i++, stage = stage->right)
+	{
+		out_fd = STDOUT_FILENO;
+		if (i + 1 < count && pipe2(fds, O_CLOEXEC) == -1)
+		{
+			perror("pipe");
+			break;
+		}
+		if (i + 1 < count)
+			out_fd = fds[1];
+		pids[i] = start_stage(msh, (stage->type == NODE_PIPE) ? stage->left
+				: stage, in_fd, out_fd);
+		if (msh->job_pgid == 0 && pids[i] > 0)
+			msh->job_pgid = pids[i]; /* the first stage leads the job */
+		if (in_fd != STDIN_FILENO)
+			close(in_fd);
+		if (out_fd != STDOUT_FILENO)
+			close(out_fd);
+		in_fd = (i + 1 < count) ? fds[0] : STDIN_FILENO;
+	}
+	if (in_fd != STDIN_FILENO)
+		close(in_fd); /* a pipe failed, nobody is left to read from it */
+	if (msh->async)
+		msh->exit_code = start_pipeline_job(msh, pids, i);
+	else
+		msh->exit_code = wait_pipeline(pids, i, msh->exit_code);
+
+	return (msh->exit_code);
+}
+
+/**
+ * spawn_stage - spawns an external command as a stage of a pipeline
+ * @msh: contains all the data relevant to the shell's operation
+ * @in_fd: the file descriptor to use as the stage's standard input
+ * @out_fd: the file descriptor to use as the stage's standard output
+ *
+ * Description: The redirections of the stage apply after the pipes, so they
+ * win over them.
+ *
+ * Return: the process ID of the stage, else the exit code of the stage as a
+ * negative number if it could not be started
+ */
+static pid_t spawn_stage(shell_t *msh, int in_fd, int out_fd)
+{
+	char path[BUFF_SIZE];
+	posix_spawn_file_actions_t actions;
+	pid_t pid = -1;
+	int error;
+
+	if (find_command(msh, msh->sub_command[0], path) == -1)
+		return (-print_cmd_not_found(msh));
+
+	posix_spawn_file_actions_init(&actions);
+	posix_spawn_file_actions_adddup2(&actions, in_fd, STDIN_FILENO);
+	posix_spawn_file_actions_adddup2(&actions, out_fd, STDOUT_FILENO);
+	add_redir_actions(msh, &actions);
+	error = spawn_command(msh, path, &actions, &pid);
+	posix_spawn_file_actions_destroy(&actions);
+	if (error != 0)
+		error = print_spawn_error(msh, error);
+	if (error != 0)
+		pid = -((error == -1) ? print_cmd_not_found(msh) : error);
+
+	return (pid);
+}
+
+/**
+ * start_stage - starts a single stage of a pipeline
+ * @msh: contains all the data relevant to the shell's operation
+ * @stage: the node of the stage
+ * @in_fd: the file descriptor to use as the stage's standard input
+ * @out_fd: the file descriptor to use as the stage's standard output
+ *
+ * Description: External commands are spawned directly. Builtins need to run
+ * shell code, so they are executed in a forked copy of the shell.
+ *
+ * Return: the process ID of the stage, else the exit code of the stage as a
+ * negative number if it could not be started
+ */
+pid_t start_stage(shell_t *msh, node_t *stage, int in_fd, int out_fd)
+{
+	const builtin_t *builtin = NULL;
+	redirect_t outer;
+	pid_t pid;
+
+	msh->sub_command = copy_words(&msh->arena, stage->words, NULL);
+	if (msh->sub_command == NULL)
+	{
+		print_error(msh, "Memory allocation failed\n");
+		return (-1);
+	}
+	expand_alias(msh);
+	msh->sub_command = handle_variables(msh);
+	if (msh->sub_command == NULL ||
+			open_redirs(msh, stage->redirs, &outer) == -1)
+		return (msh->sub_command = NULL, -CMD_ERR);
+
+	fflush(stdout); /* don't let the child inherit our pending output */
+	if (msh->sub_command[0] != NULL)
+		builtin = get_builtin(msh->sub_command);
+	if (msh->sub_command[0] == NULL)
+		pid = 0; /* nothing left to run, the stage succeeds */
+	else if (builtin != NULL)
+		pid = run_builtin_stage(msh, builtin, stage, in_fd, out_fd);
+	else
+		pid = spawn_stage(msh, in_fd, out_fd);
+	close_redirs(msh, &outer);
+	msh->sub_command = NULL;
+
+	return (pid);
+}
+
+/**
+ * run_builtin_stage - runs a builtin as a stage of a pipeline
+ * @msh: contains all the data relevant to the shell's operation
+ * @builtin: the builtin
+ * @stage: the node of the stage
+ * @in_fd: the file descriptor to use as the builtin's standard input
+ * @out_fd: the file descriptor to use as the builtin's standard output
+ *
+ * Description: Builtins without BUILTIN_PIPELINE, `fg` and `bg`, act on the
+ * shell itself and would do nothing useful in a forked copy of it.
+ *
+ * Return: the process ID of the forked shell, else -1 if the builtin can't
+ * run there or forking failed
+ */
+pid_t run_builtin_stage(shell_t *msh, const builtin_t *builtin, node_t *stage,
+		int in_fd, int out_fd)
+{
+	pid_t pid;
+
+	if (!(builtin->flags & BUILTIN_PIPELINE))
+	{
+		print_error(msh, "%s: can't be run in a pipeline or in the "
+				"background\n", builtin->name);
+		return (-1);
+	}
+	fflush(stdout); /* don't let the child inherit our pending output */
+	pid = fork();
+	if (pid == -1)
+	{
+		perror("fork");
+		return (-1);
+	}
+	if (msh->async)
+		setpgid((pid == 0) ? 0 : pid, msh->job_pgid);
+	if (pid != 0)
+		return (pid);
+
+	reset_child_signals(msh);
+	dup2(in_fd, STDIN_FILENO);
+	dup2(out_fd, STDOUT_FILENO);
+	if (in_fd != STDIN_FILENO)
+	{
+		close(in_fd);
+		msh->input = NULL; /* the shell's input isn't on fd 0 anymore */
+	}
+	if (out_fd != STDOUT_FILENO)
+		close(out_fd);
+	msh->exit_code = handle_builtin(msh, builtin, stage);
+
+	fflush(stdout);
+	_exit(msh->exit_code);
+}
+
+/**
+ * wait_pipeline - waits for all the stages of a pipeline to terminate
+ * @pids: the process IDs of the stages
+ * @count: the number of stages
+ * @exit_code: the exit code to fall back to when there are no stages
+ *
+ * Description: Stages that could not be started carry their exit code as a
+ * negative number in place of a process ID.
+ *
+ * Return: the exit code of the last stage
+ */
+int wait_pipeline(pid_t *pids, size_t count, int exit_code)
+{
+	size_t i;
+	int status;
+
+	for (i = 0; i < count; i++)
+	{
+		status = (pids[i] > 0) ? wait_command(pids[i]) : -pids[i];
+		if (i + 1 == count)
+			exit_code = status;
+	}
+
+	return (exit_code);
+}
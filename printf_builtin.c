@@ -0,0 +1,217 @@
+#include "shell.h"
+
+/**
+ * check_number - reports an argument of printf that isn't a valid number
+ * @msh: contains all the data relevant to the shell's operation
+ * @arg: the argument
+ * @end: where its conversion stopped
+ *
+ * Return: 0 if the argument is valid, else 1
+ */
+static int check_number(shell_t *msh, const char *arg, const char *end)
+{
+	const char *message = NULL;
+
+	if (end == arg)
+		message = "expected numeric value";
+	else if (*end != '\0')
+		message = "not completely converted";
+	else if (errno == ERANGE)
+		message = strerror(ERANGE);
+	if (message == NULL)
+		return (0);
+
+	print_error(msh, "printf: %s: %s\n", arg, message);
+
+	return (1);
+}
+
+/**
+ * printf_number - writes a numeric conversion of printf
+ * @msh: contains all the data relevant to the shell's operation
+ * @format: the conversion, with room for a length modifier before its
+ * conversion character
+ * @len: the position of the conversion character in @format
+ * @arg: the argument, NULL if there are none left (0)
+ *
+ * Description: Integers are converted as intmax_t, in decimal, octal (0...)
+ * or hexadecimal (0x...). An argument starting with a quote stands for the
+ * value of the character after it.
+ *
+ * Return: 0 on success, else 1 if the argument isn't a valid number
+ */
+static int printf_number(shell_t *msh, char *format, size_t len,
+		const char *arg)
+{
+	char conversion = format[len], *end = NULL;
+	intmax_t value = 0;
+	double real = 0;
+	int error;
+
+	errno = 0;
+	if (arg != NULL && (*arg == '\'' || *arg == '"'))
+		value = (unsigned char)arg[1];
+	else if (arg != NULL && _strchr("di", conversion) != NULL)
+		value = strtoimax(arg, &end, 0);
+	else if (arg != NULL && _strchr("ouxX", conversion) != NULL)
+		value = (intmax_t)strtoumax(arg, &end, 0);
+	else if (arg != NULL)
+		real = strtod(arg, &end);
+	error = (end == NULL) ? 0 : check_number(msh, arg, end);
+	if (_strchr("eEfFgGaA", conversion) != NULL)
+	{
+		if (arg != NULL && (*arg == '\'' || *arg == '"'))
+			real = value;
+		printf(format, real);
+	}
+	else
+	{
+		format[len] = 'j';
+		format[len + 1] = conversion;
+		format[len + 2] = '\0';
+		printf(format, value);
+	}
+
+	return (error);
+}
+
+/**
+ * printf_string - writes a string conversion of printf (%s, %b or %c)
+ * @format: the conversion
+ * @len: the position of the conversion character in @format
+ * @arg: the argument, NULL if there are none left (an empty string)
+ *
+ * Description: %b decodes the escape sequences of its argument the way echo
+ * does, %c writes its first character.
+ *
+ * Return: 0 on success, else -1 if a \c in the argument of %b ended the
+ * output
+ */
+static int printf_string(char *format, size_t len, const char *arg)
+{
+	buffer_t buf = {NULL, 0, 0};
+	int c = 0;
+
+	if (arg == NULL)
+		arg = "";
+	if (format[len] == 'c')
+	{
+		if (*arg != '\0')
+			printf(format, *arg);
+		return (0);
+	}
+	if (format[len] == 'b')
+	{
+		while (*arg != '\0' && c != -1)
+		{
+			c = (unsigned char)*arg;
+			arg = (*arg == '\\') ? get_escape(arg + 1, 1, &c) : arg + 1;
+			if (c != -1 && buffer_putc(&buf, c) == -1)
+				c = -1;
+		}
+		if (buffer_putc(&buf, '\0') == 0)
+			arg = buf.data;
+		format[len] = 's';
+	}
+	if (len == 1 && buf.data != NULL)
+		fwrite(buf.data, 1, buf.len - 1, stdout); /* it may have NULs */
+	else
+		printf(format, arg);
+	safe_free(buf.data);
+
+	return ((c == -1) ? -1 : 0);
+}
+
+/**
+ * printf_conversion - writes a conversion of a printf format
+ * @msh: contains all the data relevant to the shell's operation
+ * @spec: the conversion, starting with its '%'
+ * @args: a pointer to the next argument, it is moved past the one used
+ * @status: set to 1 if an argument isn't valid, 2 if the conversion isn't
+ *
+ * Description: A conversion is made of the flags "-+ #0", a width, a
+ * precision and one of the conversion characters of the C printf(), except
+ * for n and p, plus %b.
+ *
+ * Return: a pointer past the conversion, else NULL if the output ended,
+ * see printf_string(), or the conversion is invalid
+ */
+static const char *printf_conversion(shell_t *msh, const char *spec,
+		char ***args, int *status)
+{
+	char format[64];
+	const char *arg = **args;
+	size_t len = 1 + _strspn(spec + 1, "-+ #0");
+
+	len += _strspn(spec + len, "0123456789");
+	if (spec[len] == '.')
+		len += 1 + _strspn(spec + len + 1, "0123456789");
+	if (spec[1] == '%')
+		return ((putchar('%') == EOF) ? NULL : spec + 2);
+	if (len + 3 > sizeof(format) || spec[len] == '\0' ||
+			_strchr("diouxXeEfFgGaAcsb", spec[len]) == NULL)
+	{
+		print_error(msh, "printf: %.*s: invalid directive\n",
+				(int)len + (spec[len] != '\0'), spec);
+		*status = 2;
+		return (NULL);
+	}
+
+	_memcpy(format, spec, len + 1);
+	format[len + 1] = '\0';
+	if (arg != NULL)
+		(*args)++;
+	if (_strchr("csb", spec[len]) != NULL)
+		return ((printf_string(format, len, arg) == -1) ? NULL
+				: spec + len + 1);
+	*status |= printf_number(msh, format, len, arg);
+
+	return (spec + len + 1);
+}
+
+/**
+ * handle_printf - handles the builtin `printf` command
+ * @msh: contains all the data relevant to the shell's operation
+ *
+ * Description: The format is written through the buffered standard output,
+ * with its escape sequences decoded and its conversions replaced by the
+ * arguments. It is used again as long as arguments are left, and missing
+ * arguments stand for an empty string or 0.
+ *
+ * Return: 0 on success, 1 if an argument is invalid, else 2 if the format
+ * is missing or invalid
+ */
+int handle_printf(shell_t *msh)
+{
+	const char *format = msh->sub_command[1], *s;
+	char **args = msh->sub_command + 2, **start;
+	size_t len;
+	int c, status = 0;
+
+	if (format == NULL)
+	{
+		print_error(msh, "printf: usage: printf format [arg ...]\n");
+		return (2);
+	}
+	do {
+		start = args;
+		for (s = format; s != NULL && *s != '\0';)
+		{
+			len = string_span(s, "\\%", 0);
+			fwrite(s, 1, len, stdout);
+			s += len;
+			if (*s == '%')
+				s = printf_conversion(msh, s, &args, &status);
+			else if (*s == '\\')
+			{
+				s = get_escape(s + 1, 0, &c);
+				if (c != -1)
+					putchar(c);
+				else
+					s = NULL;
+			}
+		}
+	} while (s != NULL && *args != NULL && args != start);
+
+	return (status);
+}
@@ -0,0 +1,171 @@
+#include "shell.h"
+
+static prompt_t prompt; /* the prompt, rendered again only when needed */
+
+/**
+ * parse_prompt - compiles a prompt template into pieces
+ * @template: the template, in the format of PS1
+ *
+ * Description: "\u", "\h", "\w", "\W", "\?" and "\$" stand for the values
+ * they show (see the PROMPT_* macros), "\\" for a backslash, and anything
+ * else for itself.
+ *
+ * Return: 0 on success, else -1 if memory allocation failed
+ */
+static int parse_prompt(const char *template)
+{
+	static const char escapes[] = "\\uhwW?$"; /* indexed by PROMPT_* */
+	const char *s, *escape;
+	prompt_part_t *last;
+	int kind;
+
+	safe_free(prompt.template);
+	safe_free(prompt.parts);
+	prompt.count = prompt.status = 0;
+	prompt.template = _strdup(template);
+	prompt.parts = malloc(sizeof(prompt_part_t) * (_strlen(template) + 1));
+	if (prompt.template == NULL || prompt.parts == NULL)
+		return (-1);
+
+	for (s = prompt.template; *s != '\0'; s++)
+	{
+		kind = PROMPT_TEXT;
+		if (*s == '\\' && s[1] != '\0' && (escape = _strchr(escapes, s[1])))
+		{
+			kind = escape - escapes; /* "\\" is text, the second backslash */
+			s++;
+		}
+		last = (prompt.count > 0) ? &prompt.parts[prompt.count - 1] : NULL;
+		if (kind == PROMPT_TEXT && last != NULL && last->kind == PROMPT_TEXT &&
+				last->text + last->len == s)
+			last->len++;
+		else
+		{
+			prompt.parts[prompt.count].kind = kind;
+			prompt.parts[prompt.count].text = s;
+			prompt.parts[prompt.count++].len = (kind == PROMPT_TEXT);
+		}
+		prompt.status |= (kind == PROMPT_STATUS);
+	}
+
+	return (0);
+}
+
+/**
+ * put_dir - appends the working directory to the rendered prompt
+ * @buf: the rendered prompt
+ * @base: true to only show the last component of the directory (\W)
+ *
+ * Return: 0 on success, else -1 if memory allocation failed
+ */
+static int put_dir(buffer_t *buf, int base)
+{
+	const char *pwd = _getenv("PWD"), *home = _getenv("HOME"), *last;
+	size_t len = (home != NULL) ? _strlen(home) : 0;
+
+	if (pwd == NULL)
+		return (0);
+	if (len > 1 && !_strncmp(pwd, home, len) &&
+			(pwd[len] == '\0' || (pwd[len] == '/' && !base)))
+	{
+		if (buffer_putc(buf, '~') == -1)
+			return (-1);
+		pwd += len;
+	}
+	else if (base && pwd[0] == '/' && pwd[1] != '\0')
+	{
+		last = _strrchr(pwd, '/');
+		pwd = (last[1] != '\0') ? last + 1 : pwd;
+	}
+
+	return (buffer_write(buf, pwd, _strlen(pwd)));
+}
+
+/**
+ * render_prompt - renders the prompt from its compiled template
+ * @exit_code: the exit code of the last command
+ *
+ * Return: 0 on success, else -1 if memory allocation failed
+ */
+static int render_prompt(int exit_code)
+{
+	const char *value;
+	char number[32];
+	size_t i;
+	int error = 0;
+
+	prompt.text.len = 0;
+	for (i = 0; i < prompt.count && !error; i++)
+	{
+		value = NULL;
+		if (prompt.parts[i].kind == PROMPT_TEXT)
+			error = buffer_write(&prompt.text, prompt.parts[i].text,
+					prompt.parts[i].len);
+		else if (prompt.parts[i].kind == PROMPT_CWD ||
+				prompt.parts[i].kind == PROMPT_CWD_BASE)
+			error = put_dir(&prompt.text,
+					prompt.parts[i].kind == PROMPT_CWD_BASE);
+		else if (prompt.parts[i].kind == PROMPT_USER)
+			value = _getenv("USER");
+		else if (prompt.parts[i].kind == PROMPT_HOST)
+		{
+			if (*prompt.hostname == '\0')
+				get_hostname(prompt.hostname);
+			error = buffer_write(&prompt.text, prompt.hostname,
+					string_span(prompt.hostname, ".", 0));
+		}
+		else if (prompt.parts[i].kind == PROMPT_STATUS)
+		{
+			_itoa(exit_code, number);
+			value = number;
+		}
+		else
+			value = (geteuid() == 0) ? "#" : "$";
+		if (value != NULL)
+			error = buffer_write(&prompt.text, value, _strlen(value));
+	}
+	prompt.exit_code = exit_code;
+	prompt.generation = get_env_store()->generation;
+
+	return (error);
+}
+
+/**
+ * show_prompt - shows the prompt, in interactive mode only
+ * @msh: contains all the data relevant to the shell's operation, NULL to show
+ * the prompt as it was last rendered (e.g. from a signal handler)
+ *
+ * Description: The prompt is compiled from PS1, or from "[\u@\h \W]% " when
+ * PS1 isn't set. It is only rendered again when a variable changed or, if it
+ * shows it, when the exit code changed.
+ */
+void show_prompt(const shell_t *msh)
+{
+	const char *template;
+
+	if (msh != NULL && (prompt.template == NULL || prompt.generation !=
+				get_env_store()->generation ||
+				(prompt.status && prompt.exit_code != msh->exit_code)))
+	{
+		template = _getenv("PS1");
+		if (template == NULL)
+			template = (_getenv("USER") != NULL) ? "[\\u@\\h \\W]% " : "msh% ";
+		if ((prompt.template == NULL || _strcmp(template, prompt.template)) &&
+				parse_prompt(template) == -1)
+			prompt.count = 0;
+		if (render_prompt(msh->exit_code) == -1)
+			prompt.text.len = 0;
+	}
+
+	fwrite(prompt.text.data, 1, prompt.text.len, stdout);
+}
+
+/**
+ * free_prompt - frees the prompt
+ */
+void free_prompt(void)
+{
+	multi_free("ss", prompt.template, prompt.text.data);
+	safe_free(prompt.parts);
+	prompt.count = prompt.text.len = prompt.text.size = 0;
+}
@@ -0,0 +1,82 @@
+#include "shell.h"
+
+/**
+ * redir_length - measures the redirection operator at the start of a string,
+ * along with the file descriptor written right before it, e.g. `2>&`
+ * @s: the string
+ *
+ * Return: the length of the operator, else 0 if @s doesn't start with one
+ */
+size_t redir_length(const char *s)
+{
+	size_t len = 0;
+
+	while (isdigit(s[len]))
+		len++;
+	s += len;
+	if (*s != '<' && *s != '>')
+		return (0);
+	if (s[0] == '<' && s[1] == '<' && s[2] == '-')
+		return (len + 3);
+	if ((s[0] == '<' && _strchr("<&>", s[1]) != NULL) ||
+			(s[0] == '>' && _strchr(">&|", s[1]) != NULL))
+		return ((s[1] == '\0') ? len + 1 : len + 2);
+
+	return (len + 1);
+}
+
+/**
+ * redir_type - looks up the kind of a redirection operator
+ * @op: the operator, without its file descriptor
+ * @len: the length of @op
+ *
+ * Return: the kind of redirection (one of the REDIR_* macros)
+ */
+static int redir_type(const char *op, size_t len)
+{
+	const char *ops[] = {"<", "<<", "<<-", "<>", "<&", ">", ">|", ">>",
+		">&"};
+	const int types[] = {REDIR_IN, REDIR_DELIM, REDIR_DELIM_TABS,
+		REDIR_RDWR, REDIR_DUP, REDIR_OUT, REDIR_OUT, REDIR_APPEND,
+		REDIR_DUP};
+	size_t i;
+
+	for (i = 0; i < sizeof(types) / sizeof(types[0]) - 1; i++)
+		if (_strlen(ops[i]) == len && !_strncmp(op, ops[i], len))
+			break;
+
+	return (types[i]);
+}
+
+/**
+ * add_redir - adds a redirection to the node of a simple command
+ * @lexer: the token stream
+ * @arena: the arena to allocate the redirection from
+ * @node: the node, the redirection goes after the ones it already has
+ * @token: the TOK_REDIR token, followed by the word of its target
+ *
+ * Description: The target points into the line, like the words of the
+ * command. Without a file descriptor, `<` redirections apply to the standard
+ * input and `>` ones to the standard output.
+ *
+ * Return: 0 on success, else -1 on failure
+ */
+int add_redir(lexer_t *lexer, arena_t *arena, node_t *node, token_t *token)
+{
+	const char *op = lexer->line + token->offset;
+	size_t digits = _strspn(op, "0123456789");
+	redir_t *redir = arena_alloc(arena, sizeof(redir_t)), **tail;
+
+	if (redir == NULL)
+		return (-1);
+
+	redir->fd = (digits > 0) ? _atoi(op) : (op[0] == '>');
+	redir->type = redir_type(op + digits, token->length - digits);
+	redir->target = (char *)lexer->line + token[1].offset;
+	redir->next = NULL;
+	for (tail = &node->redirs; *tail != NULL; tail = &(*tail)->next)
+		;
+	*tail = redir;
+
+	return (0);
+}
@@ -0,0 +1,188 @@
+#include "shell.h"
+
+/**
+ * expand_target - expands the target of a redirection into msh->target
+ * @msh: contains all the data relevant to the shell's operation
+ * @word: the target, as written on the command line
+ *
+ * Description: msh->expansion holds the words of the command, so the target
+ * is expanded in a buffer of its own. Targets without quotes, backslashes or
+ * parameters are used as they are.
+ *
+ * Return: the expanded target, else NULL on a bad substitution
+ */
+static char *expand_target(shell_t *msh, char *word)
+{
+	buffer_t words = msh->expansion;
+	const char *end;
+	int quoted = 0;
+
+	if (_strpbrk(word, "'\"\\$") == NULL)
+		return (word);
+
+	msh->expansion = msh->target;
+	msh->expansion.len = 0;
+	end = expand_text(msh, word, '\0', &quoted, 0);
+	if (end != NULL && buffer_putc(&msh->expansion, '\0') == -1)
+		end = NULL;
+	msh->target = msh->expansion;
+	msh->expansion = words;
+	if (end == NULL)
+		print_error(msh, "Bad substitution\n");
+
+	return ((end == NULL) ? NULL : msh->target.data);
+}
+
+/**
+ * open_target - opens the file of a redirection
+ * @msh: contains all the data relevant to the shell's operation
+ * @redir: the redirection
+ *
+ * Description: The file is opened with O_CLOEXEC, so it only reaches the
+ * command once it is copied to the redirected file descriptor. The target of
+ * `<&` and `>&` is a file descriptor number, which isn't opened, or `-`.
+ *
+ * Return: the file descriptor, -1 if the redirected file descriptor is to be
+ * closed, else -2 on errors, which are reported
+ */
+static int open_target(shell_t *msh, redir_t *redir)
+{
+	const int flags[] = {0, O_RDONLY, O_WRONLY | O_CREAT | O_TRUNC,
+		O_WRONLY | O_CREAT | O_APPEND, O_RDWR | O_CREAT};
+	char *target;
+	int fd;
+
+	if (redir->type >= REDIR_HEREDOC)
+		return (((fd = heredoc_fd(msh, redir)) == -1) ? -2 : fd);
+	target = expand_target(msh, redir->target);
+	if (target == NULL)
+		return (-2);
+	if (redir->type == REDIR_DUP && !_strcmp(target, "-"))
+		return (-1);
+	if (redir->type == REDIR_DUP && (*target == '\0' ||
+				target[_strspn(target, "0123456789")] != '\0'))
+	{
+		print_error(msh, "%s: Bad fd number\n", target);
+		return (-2);
+	}
+	if (redir->type == REDIR_DUP)
+		return (_atoi(target));
+
+	fd = open(target, flags[redir->type] | O_CLOEXEC, 0666);
+	if (fd == -1)
+		print_error(msh, "cannot %s %s: %s\n",
+				(redir->type == REDIR_IN) ? "open" : "create",
+				target, strerror(errno));
+
+	return ((fd == -1) ? -2 : fd);
+}
+
+/**
+ * open_redirs - opens the files of the redirections of the simple command
+ * about to run, into msh->redirect
+ * @msh: contains all the data relevant to the shell's operation
+ * @redirs: the redirections, can be NULL
+ * @outer: where to save the redirections of the command running this one,
+ * if any, for close_redirs()
+ *
+ * Description: The files are moved to SHELL_FD_MIN or above, so that one
+ * redirection can't clobber the file of another when they are copied into
+ * place.
+ *
+ * Return: 0 on success, else -1 if a file couldn't be opened, which is
+ * reported, and nothing is left open
+ */
+int open_redirs(shell_t *msh, redir_t *redirs, redirect_t *outer)
+{
+	redirect_t *redirect = &msh->redirect;
+	redir_t *redir;
+	size_t count = 0;
+	int fd;
+
+	*outer = *redirect;
+	if (redirs != NULL)
+		fflush(stdout); /* keep the output in order with the errors */
+	for (redir = redirs; redir != NULL; redir = redir->next)
+		count++;
+	redirect->redirs = redirs;
+	redirect->count = 0;
+	redirect->fds = (count == 0) ? NULL
+		: arena_alloc(&msh->arena, sizeof(int) * count);
+
+	for (redir = redirs; redir != NULL && redirect->fds != NULL;
+			redir = redir->next)
+	{
+		fd = open_target(msh, redir);
+		if (fd >= 0 && redir->type != REDIR_DUP &&
+				(fd = move_fd(fd)) == -1)
+			fd = (perror("fcntl"), -2);
+		if (fd == -2)
+			break;
+		redirect->fds[redirect->count++] = fd;
+	}
+	if (redirect->count == count)
+		return (0);
+
+	close_redirs(msh, outer);
+
+	return (-1);
+}
+
+/**
+ * close_redirs - closes the files of the redirections opened by
+ * open_redirs(), and brings back the ones it saved
+ * @msh: contains all the data relevant to the shell's operation
+ * @outer: the redirections saved by open_redirs()
+ */
+void close_redirs(shell_t *msh, redirect_t *outer)
+{
+	redirect_t *redirect = &msh->redirect;
+	redir_t *redir = redirect->redirs;
+	size_t i;
+
+	for (i = 0; i < redirect->count; i++, redir = redir->next)
+		if (redir->type != REDIR_DUP && redirect->fds[i] >= 0)
+			close(redirect->fds[i]);
+
+	*redirect = *outer;
+}
+
+/**
+ * apply_redirs - applies the redirections opened by open_redirs() to the
+ * shell itself, in order
+ * @msh: contains all the data relevant to the shell's operation
+ * @saved: where to save a copy of every redirected file descriptor, -1 for
+ * those that weren't open and -2 for those left alone after an error, see
+ * restore_redirs(); NULL in a child that is about to run a program
+ *
+ * Return: 0 on success, else -1 if a file descriptor couldn't be copied,
+ * which is reported
+ */
+int apply_redirs(shell_t *msh, int *saved)
+{
+	redirect_t *redirect = &msh->redirect;
+	redir_t *redir = redirect->redirs;
+	size_t i;
+	int fd, status = 0;
+
+	fflush(stdout); /* the pending output goes where it was meant to */
+	for (i = 0; i < redirect->count; i++, redir = redir->next)
+	{
+		fd = redirect->fds[i];
+		if (saved != NULL)
+			saved[i] = (status == -1) ? -2 : fcntl(redir->fd,
+					F_DUPFD_CLOEXEC, SHELL_FD_MIN);
+		if (status == -1)
+			continue;
+		if (fd == -1)
+			close(redir->fd);
+		if (fd == -1 || dup2(fd, redir->fd) != -1)
+			continue;
+		if (redir->type != REDIR_DUP)
+			fd = redir->fd; /* the one at fault */
+		print_error(msh, "%d: %s\n", fd, strerror(errno));
+		status = -1;
+	}
+
+	return (status);
+}
@@ -0,0 +1,138 @@
+#include "shell.h"
+
+/**
+ * run_script - runs a script one line at a time while it is being read,
+ * compiling it into a cache for the next runs
+ * @msh: contains all the data relevant to the shell's operation
+ * @filename: the path of the script
+ * @fd: the file descriptor of the script
+ * @skip: the number of lines that already ran from a cache, which are only
+ * compiled
+ */
+void run_script(shell_t *msh, const char *filename, int fd, size_t skip)
+{
+	size_t n = 0;
+	ssize_t n_read;
+
+	msh->input = get_reader(fd);
+	if (msh->input == NULL)
+	{
+		msh->exit_code = -1;
+		return;
+	}
+	start_cache(msh, filename, fd);
+
+	while ((n_read = _getline(&msh->line, &n, fd)) > 0)
+	{
+		++msh->cmd_count; /* errors are reported with the line number */
+		if (msh->cmd_count > skip)
+		{
+			msh->exit_code = parse_line(msh);
+			continue;
+		}
+		compile_line(msh);
+		msh->tree = NULL;
+		arena_reset(&msh->arena);
+	}
+	if (n_read == -1)
+		msh->exit_code = -1;
+
+	finish_cache(msh);
+	release_reader(fd);
+	msh->input = NULL;
+}
+
+/**
+ * run_cache - runs a script from its compiled cache, in msh->cache
+ * @msh: contains all the data relevant to the shell's operation
+ * @filename: the path of the script
+ *
+ * Description: The command trees are loaded one line at a time into the
+ * shell's arena, from one block of the cache at a time, so the script is
+ * neither read nor parsed and memory use doesn't depend on its size. When a
+ * block turns out to be bad, the lines from there on run from the script,
+ * which is compiled into a new cache.
+ */
+void run_cache(shell_t *msh, const char *filename)
+{
+	script_cache_t *cache = msh->cache;
+	size_t line = 0;
+	int fd = cache->script_fd, status = 1;
+
+	while (cache->pos < cache->len || (status = get_block(cache)) == 1)
+	{
+		if (get_number(cache, &msh->cmd_count) == -1)
+			break;
+		line = msh->cmd_count; /* the last line this tree was read from */
+		msh->tree = get_node(cache, &msh->arena);
+		if (msh->tree != NULL)
+			execute_tree(msh, msh->tree);
+		msh->tree = NULL;
+		arena_reset(&msh->arena);
+		buffer_trim(&msh->expansion);
+		buffer_trim(&msh->target);
+		if (cache->failed)
+			break;
+	}
+
+	if (cache->failed)
+	{
+		print_error(msh, "Memory allocation failed\n");
+		msh->exit_code = -1;
+	}
+	free_cache(&msh->cache);
+	if (status == -1)
+	{
+		msh->cmd_count = 0;
+		run_script(msh, filename, fd, line);
+	}
+}
+
+/**
+ * start_cache - starts compiling a script into a cache while it runs
+ * @msh: contains all the data relevant to the shell's operation
+ * @filename: the path of the script
+ * @script_fd: the file descriptor of the script
+ *
+ * Description: The compiled commands are written to a temporary file next to
+ * the script, which only replaces the cache once the whole script is
+ * compiled. Scripts that can't be cached, e.g. because their directory is
+ * read-only, simply run without a cache.
+ */
+void start_cache(shell_t *msh, const char *filename, int script_fd)
+{
+	script_cache_t *cache = malloc(sizeof(script_cache_t));
+
+	if (cache == NULL)
+		return;
+
+	cache->fd = cache->load_fd = -1;
+	cache->script_fd = script_fd;
+	cache->temp_path = NULL;
+	cache->size = READ_SIZE;
+	cache->len = cache->pos = 0;
+	cache->failed = 0;
+	cache->buffer = malloc(READ_SIZE);
+	cache->path = cache_path(filename);
+	if (cache->path != NULL)
+		cache->temp_path = malloc(_strlen(cache->path) + 8);
+	if (cache->buffer == NULL || cache->temp_path == NULL ||
+			set_cache_key(&cache->header, script_fd) == -1)
+	{
+		free_cache(&cache);
+		return;
+	}
+
+	_strcpy(cache->temp_path, cache->path);
+	_strcat(cache->temp_path, ".XXXXXX");
+	cache->fd = move_fd(mkostemp(cache->temp_path, O_CLOEXEC));
+	if (cache->fd == -1)
+		safe_free(cache->temp_path); /* nothing to remove */
+
+	/* the header is written last, once the compiled commands are known */
+	if (cache->fd == -1 ||
+			lseek(cache->fd, sizeof(cache_header_t), SEEK_SET) == -1)
+		free_cache(&cache);
+
+	msh->cache = cache;
+}
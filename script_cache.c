@@ -0,0 +1,140 @@
+#include "shell.h"
+
+/**
+ * cache_path - builds the path of the compiled cache of a script
+ * @filename: the path of the script
+ *
+ * Description: The cache is a hidden file next to the script, e.g. the cache
+ * of "jobs/backup.sh" is "jobs/.backup.sh.mshc".
+ *
+ * Return: the path of the cache, else NULL on failure
+ */
+char *cache_path(const char *filename)
+{
+	const char *base = _strrchr(filename, '/');
+	size_t dir_len = (base == NULL) ? 0 : (size_t)(base - filename) + 1;
+	char *path = malloc(_strlen(filename) + _strlen(CACHE_SUFFIX) + 2);
+
+	if (path == NULL)
+		return (NULL);
+
+	_memcpy(path, filename, dir_len);
+	path[dir_len] = '.';
+	_strcpy(path + dir_len + 1, filename + dir_len);
+	_strcat(path, CACHE_SUFFIX);
+
+	return (path);
+}
+
+/**
+ * set_cache_key - fills the header of a cache with what identifies the
+ * current version of a script
+ * @header: the header to fill
+ * @fd: the file descriptor of the script
+ *
+ * Return: 0 on success, else -1 if the script can't be cached
+ */
+int set_cache_key(cache_header_t *header, int fd)
+{
+	struct stat info;
+
+	memset(header, 0, sizeof(cache_header_t));
+	if (fstat(fd, &info) == -1 || !S_ISREG(info.st_mode))
+		return (-1);
+
+	_memcpy(header->magic, CACHE_MAGIC, sizeof(header->magic));
+	header->version = CACHE_VERSION;
+	header->dev = info.st_dev;
+	header->ino = info.st_ino;
+	header->size = info.st_size;
+	header->mtime = info.st_mtim.tv_sec;
+	header->mtime_nsec = info.st_mtim.tv_nsec;
+
+	return (0);
+}
+
+/**
+ * cache_matches - checks whether a cache was compiled from the current
+ * version of a script
+ * @header: the header of the cache
+ * @fd: the file descriptor of the script
+ *
+ * Return: 1 if it was, else 0
+ */
+int cache_matches(const cache_header_t *header, int fd)
+{
+	cache_header_t key;
+
+	if (set_cache_key(&key, fd) == -1)
+		return (0);
+
+	return (!_strncmp(header->magic, key.magic, sizeof(key.magic)) &&
+			header->version == key.version && header->dev == key.dev &&
+			header->ino == key.ino && header->size == key.size &&
+			header->mtime == key.mtime && header->mtime_nsec == key.mtime_nsec);
+}
+
+/**
+ * load_cache - loads the compiled cache of a script
+ * @filename: the path of the script
+ * @script_fd: the file descriptor of the script
+ *
+ * Description: The cache is only trusted if it belongs to the user running
+ * the shell and nobody else can write to it, since its commands are run
+ * without looking at the script. Only its header is read here, its blocks
+ * are loaded one at a time as the script runs, see get_block().
+ *
+ * Return: the cache, else NULL if there is no usable cache
+ */
+script_cache_t *load_cache(const char *filename, int script_fd)
+{
+	struct stat info;
+	script_cache_t *cache = NULL;
+	char *path = cache_path(filename);
+	int fd = (path == NULL) ? -1 : open(path, O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+
+	safe_free(path);
+	if (fd == -1)
+		return (NULL);
+	if (fstat(fd, &info) == -1 || !S_ISREG(info.st_mode) ||
+			info.st_uid != geteuid() || (info.st_mode & (S_IWGRP | S_IWOTH)) ||
+			(size_t)info.st_size < sizeof(cache_header_t) ||
+			(cache = malloc(sizeof(script_cache_t))) == NULL)
+		return (close(fd), NULL);
+
+	cache->fd = -1;
+	cache->load_fd = move_fd(fd);
+	cache->script_fd = script_fd;
+	cache->path = cache->temp_path = cache->buffer = NULL;
+	cache->size = cache->len = cache->pos = 0;
+	cache->failed = 0;
+	if (cache->load_fd == -1 ||
+			read_full(cache->load_fd, &cache->header,
+				sizeof(cache_header_t)) == -1 ||
+			!cache_matches(&cache->header, script_fd) ||
+			cache->header.length !=
+			(size_t)info.st_size - sizeof(cache_header_t))
+		free_cache(&cache);
+
+	return (cache);
+}
+
+/**
+ * free_cache - frees a script cache, a cache that was being written but not
+ * completed is removed
+ * @cache: a pointer to the cache, it is set to NULL
+ */
+void free_cache(script_cache_t **cache)
+{
+	if (cache == NULL || *cache == NULL)
+		return;
+
+	if ((*cache)->fd != -1)
+		close((*cache)->fd);
+	if ((*cache)->load_fd != -1)
+		close((*cache)->load_fd);
+	if ((*cache)->temp_path != NULL)
+		unlink((*cache)->temp_path);
+	multi_free("sss", (*cache)->path, (*cache)->temp_path, (*cache)->buffer);
+	safe_free(*cache);
+}
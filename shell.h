@@ -1,17 +1,27 @@
 #ifndef SHELL_H
 #define SHELL_H
 
+#define _GNU_SOURCE
+
 #include <errno.h>
 #include <fcntl.h>
-#include <regex.h>
+#include <fnmatch.h>
+#include <inttypes.h>
+#include <malloc.h>
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <signal.h>
+#include <spawn.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
 #include <sys/stat.h>
+#include <sys/time.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <sys/wait.h>
+#include <time.h>
 #include <unistd.h>
 
 /* macros */
@@ -19,34 +29,95 @@
 #define BUFF_SIZE 1024
 #define SPACE ' '
 #define CMD_NOT_FOUND 127
-#define PROMPT_SIZE 4096
 #define PATH_SIZE 2048
-#define NOT_BUILTIN 18
 #define RUNNING 1
 #define CMD_ERR 2
-#define MAX_ALIAS_LENGTH 50
-#define MAX_VALUE_LENGTH 2048
+#define HASH_SIZE 64
+#define IOV_BATCH 1024
+#define ENV_MIN_BUCKETS 64
+#define ALIAS_MIN_BUCKETS 64
+#define READ_SIZE 65536
+#define MAX_READER_FD 64
+#define SHELL_FD_MIN 10 /* the shell's own files stay clear of 0 to 9 */
+#define JOB_RUNNING 0
+#define JOB_STOPPED 1
+#define JOB_DONE 2
+#define CC_WORD 0
+#define CC_BLANK 1
+#define CC_SEMI 2
+#define CC_AMP 3
+#define CC_PIPE 4
+#define CC_HASH 5
+#define CC_END 6
+#define CC_REDIR 7
+#define TOK_WORD 0
+#define TOK_SEMI 1
+#define TOK_AMP 2
+#define TOK_AND 3
+#define TOK_OR 4
+#define TOK_PIPE 5
+#define TOK_END 6
+#define TOK_REDIR 7
+#define NODE_CMD 1
+#define NODE_PIPE 2
+#define NODE_AND 3
+#define NODE_OR 4
+#define NODE_SEQ 5
+#define NODE_ASYNC 6
+#define NODE_TIME 7
+#define REDIR_IN 1 /* < */
+#define REDIR_OUT 2 /* > and >| */
+#define REDIR_APPEND 3 /* >> */
+#define REDIR_RDWR 4 /* <> */
+#define REDIR_DUP 5 /* <& and >& */
+#define REDIR_HEREDOC 6 /* <<, the body is expanded */
+#define REDIR_HEREDOC_RAW 7 /* <<, the delimiter was quoted */
+#define REDIR_DELIM 8 /* <<, the body wasn't read yet */
+#define REDIR_DELIM_TABS 9 /* <<-, the body wasn't read yet */
+#define CACHE_MAGIC "MSHC"
+#define CACHE_VERSION 10 /* bump whenever the parser or node_t changes */
+#define CACHE_SUFFIX ".mshc"
+#define ARENA_BLOCK_SIZE 65536
+#define LINE_MEMORY_MAX (1 << 20) /* the most kept from one line to the next */
+#define ARENA_ALIGN 16
+#define SPAN_SET_MAX 16 /* larger sets are scanned one byte at a time */
+#define BUILTIN_SLOTS 64 /* a power of two */
+#define BUILTIN_PIPELINE 1
+#define BUILTIN_SOURCE 2
+#define BUILTIN_BARE 4
+#define BUILTIN_CAPTURE 8
+#define PARALLEL_MAX_JOBS 4096
+#define CAPTURE_READ 65536 /* the capacity of a pipe on Linux */
+#define TIME_FORMAT \
+	"\nreal\t%3lR\nuser\t%3lU\nsys\t%3lS\nrss\t%M KiB\nfaults\t%F major, %f minor"
+
+/* the vectorized string primitives are only built for x86 CPUs */
+#if defined(__x86_64__) || defined(__i386__)
+#define MSH_X86
+#endif
 
 /* function macros */
 
 #define isspace(c) ((c) == SPACE)
+#define isblank(c) ((c) == SPACE || (c) == '\t')
 #define isdigit(c) (((c) >= '0' && (c) <= '9')) /* checks for digits */
 #define isalpha(c) (((c) >= 'a' && (c) <= 'z') || ((c) >= 'A' && (c) <= 'Z'))
 #define isnegative(c) (((c) == '-') ? -1 : 1)
 #define issign(c) ((c) == '-' || (c) == '+')
 #define isquote(c) ((c) == '"' || (c) == '\'')
+/* a ${...} expansion or a $(...) command substitution starting at s */
+#define isbraced(s) (*(s) == '$' && ((s)[1] == '{' || (s)[1] == '('))
+/* the number of seconds in a struct timeval */
+#define TV_SECONDS(tv) ((tv).tv_sec + (tv).tv_usec / 1e6)
+/* rounds a size up to the alignment of arena allocations */
+#define ARENA_ALIGN_UP(n) (((n) + ARENA_ALIGN - 1) & ~((size_t)ARENA_ALIGN - 1))
 
 /* string handlers */
 
-size_t _strlen(const char *s);
 char *_strdup(const char *str);
-char *_strchr(const char *s, int c);
 char *_strrchr(const char *s, int c);
 char *_strcpy(char *dest, const char *src);
 char *_strcat(char *dest, const char *src);
-int _strcmp(const char *s1, const char *s2);
-char **duplicate_str_array(char **original);
-void concatenate_arrays(char ***dest, char **src);
 char *_strpbrk(const char *s, const char *accept);
 size_t _strspn(const char *s, const char *accept);
 char **_strtok(const char *str, const char *delim);
@@ -55,17 +126,48 @@ int _strncmp(const char *s1, const char *s2, size_t n);
 int get_word_count(const char *str, const char *delim);
 char *_strstr(const char *haystack, const char *needle);
 
+/*
+ * the string primitives on hot paths, they point to the fastest versions the
+ * CPU supports once init_string_ops() ran
+ */
+
+extern size_t (*_strlen)(const char *s);
+extern char *(*_strchr)(const char *s, int c);
+extern int (*_strcmp)(const char *s1, const char *s2);
+extern void *(*_memcpy)(void *dest, const void *src, size_t n);
+extern size_t (*string_span)(const char *s, const char *set, int in_set);
+void init_string_ops(void);
+
+size_t strlen_scalar(const char *s);
+char *strchr_scalar(const char *s, int c);
+int strcmp_scalar(const char *s1, const char *s2);
+void *memcpy_scalar(void *dest, const void *src, size_t n);
+size_t span_scalar(const char *s, const char *set, int in_set);
+
+#ifdef MSH_X86
+size_t strlen_sse2(const char *s);
+char *strchr_sse2(const char *s, int c);
+int strcmp_sse2(const char *s1, const char *s2);
+void *memcpy_sse2(void *dest, const void *src, size_t n);
+size_t span_sse2(const char *s, const char *set, int in_set);
+size_t strlen_avx2(const char *s);
+char *strchr_avx2(const char *s, int c);
+void *memcpy_avx2(void *dest, const void *src, size_t n);
+size_t span_avx2(const char *s, const char *set, int in_set);
+#endif /* MSH_X86 */
+
 /* numbers */
 
 int _atoi(const char *s);
 void _itoa(size_t n, char *s);
 void _reverse(char *buffer, size_t len);
+size_t hash_string(const char *str);
+size_t hash_bytes(const char *str, size_t len);
 
 /* memory handlers */
 
 void free_str(char ***str_array);
 char *new_word(const char *str, int start, int end);
-void *_memcpy(void *dest, const void *src, size_t n);
 void *_realloc(void *old_mem_blk, size_t old_size, size_t new_size);
 
 /* a safer way to deallocate dynamic memory */
@@ -75,11 +177,141 @@ void _free(void **ptr);
 /* frees memory for a variable number of objects */
 void multi_free(const char *format, ...);
 
+/* per-line memory */
+
+/**
+ * struct arena_block - a block of memory of an arena, the memory itself
+ * follows the header
+ * @size: the number of bytes of memory in the block
+ * @used: the number of bytes handed out so far
+ * @next: the block allocated before this one
+ */
+typedef struct arena_block
+{
+	size_t size;
+	size_t used;
+	struct arena_block *next;
+} arena_block_t;
+
+/**
+ * struct arena - an allocator whose memory is all given back at once
+ * @block: the block memory is handed out from, the most recent one
+ *
+ * Description: Everything a command line needs while it is parsed and
+ * expanded is allocated from the shell's arena, which is reset once the line
+ * ran. Nothing allocated from it may outlive the line.
+ */
+typedef struct arena
+{
+	arena_block_t *block;
+} arena_t;
+
+void *arena_alloc(arena_t *arena, size_t size);
+char *arena_strndup(arena_t *arena, const char *str, size_t len);
+char *arena_strdup(arena_t *arena, const char *str);
+void arena_reset(arena_t *arena);
+void free_arena(arena_t *arena);
+void print_alloc_stats(void);
+char **copy_words(arena_t *arena, char **words, char **rest);
+char **split_words(arena_t *arena, const char *str);
+char **pack_words(char **words);
+
+/**
+ * struct buffer - a growable buffer
+ * @data: the bytes written so far
+ * @len: the number of bytes written
+ * @size: the number of bytes allocated
+ */
+typedef struct buffer
+{
+	char *data;
+	size_t len;
+	size_t size;
+} buffer_t;
+
+int buffer_reserve(buffer_t *buf, size_t extra);
+int buffer_write(buffer_t *buf, const char *str, size_t len);
+int buffer_putc(buffer_t *buf, char c);
+void buffer_trim(buffer_t *buf);
+
 /* a custom implementation of the getline function */
 ssize_t _getline(char **lineptr, size_t *n, int fd);
 
-/* shows the prompt in interactive mode */
-void show_prompt(void);
+/**
+ * struct reader - a buffered line reader
+ * @fd: the file descriptor to read from
+ * @buffer: the data read from @fd
+ * @size: the size of @buffer
+ * @start: the offset of the first byte in @buffer not handed out yet
+ * @end: the offset past the last byte read into @buffer
+ */
+typedef struct reader
+{
+	int fd;
+	char *buffer;
+	size_t size;
+	size_t start;
+	size_t end;
+} reader_t;
+
+reader_t *new_reader(int fd);
+ssize_t read_line(reader_t *reader, char **lineptr, size_t *n);
+void free_reader(reader_t **reader);
+reader_t *get_reader(int fd);
+void release_reader(int fd);
+void free_readers(void);
+
+/* output handlers */
+
+int write_lines(int fd, char **lines);
+int writev_all(int fd, struct iovec *iov, size_t count);
+int move_fd(int fd);
+
+/* the prompt, shown in interactive mode */
+
+#define PROMPT_TEXT 0 /* text from the template */
+#define PROMPT_USER 1 /* \u, the user name */
+#define PROMPT_HOST 2 /* \h, the hostname up to the first '.' */
+#define PROMPT_CWD 3 /* \w, the working directory, with $HOME shown as ~ */
+#define PROMPT_CWD_BASE 4 /* \W, the last component of the working directory */
+#define PROMPT_STATUS 5 /* \?, the exit code of the last command */
+#define PROMPT_SIGIL 6 /* \$, '#' for root, else '$' */
+
+/**
+ * struct prompt_part - a piece of a compiled prompt template
+ * @kind: what the piece stands for (one of the PROMPT_* macros)
+ * @text: the text of a PROMPT_TEXT piece, in the template
+ * @len: the length of @text
+ */
+typedef struct prompt_part
+{
+	int kind;
+	const char *text;
+	size_t len;
+} prompt_part_t;
+
+/**
+ * struct prompt - the prompt, compiled from the PS1 template
+ * @template: the template the prompt was compiled from
+ * @parts: the pieces of the template
+ * @count: the number of pieces
+ * @status: true if the template shows the exit code
+ * @generation: the generation of the environment the prompt was rendered in
+ * @exit_code: the exit code the prompt was rendered with
+ * @hostname: the hostname, read once when a template first shows it
+ * @text: the rendered prompt
+ */
+typedef struct prompt
+{
+	char *template;
+	prompt_part_t *parts;
+	size_t count;
+	int status;
+	size_t generation;
+	int exit_code;
+	char hostname[100];
+	buffer_t text;
+} prompt_t;
 
 /* retrieves the hostname from the '/etc/hostname' file */
 char *get_hostname(char *buffer);
@@ -100,92 +332,635 @@ typedef struct _path
 	struct _path *next;
 } path_t;
 
-void _printenv(void);
 void print_path(path_t *list);
 void free_list(path_t **head);
 char *_getenv(const char *name);
 path_t *build_path(path_t **head);
 
+/**
+ * struct var - an environment variable in the shell's variable store
+ * @entry: the variable as a "NAME=value" string, the way programs receive it
+ * @name_len: the length of the NAME part of @entry
+ * @hash: the hash value of the name
+ * @next: a pointer to the next variable in the same bucket
+ * @prev_var: the variable defined just before this one
+ * @next_var: the variable defined just after this one
+ */
+typedef struct var
+{
+	char *entry;
+	size_t name_len;
+	size_t hash;
+	struct var *next;
+	struct var *prev_var;
+	struct var *next_var;
+} var_t;
+
+/**
+ * struct env_store - the shell's environment, indexed by variable name
+ * @buckets: the buckets of the hash table
+ * @size: the number of buckets, always a power of two
+ * @count: the number of variables in the store
+ * @first: the first variable, in the order they were defined
+ * @last: the last variable, in the order they were defined
+ * @envp: the environment as handed to programs, built only when needed
+ * @envp_size: the number of entries @envp has room for
+ * @changed: true if the variables changed since @envp was last built
+ * @retired: the strings of the variables replaced or removed since @envp was
+ * last built, which `environ` may still point to
+ * @retired_count: the number of strings in @retired
+ * @retired_size: the number of strings @retired has room for
+ * @generation: incremented whenever a variable changes, so values derived
+ * from the variables know when to be computed again
+ */
+typedef struct env_store
+{
+	var_t **buckets;
+	size_t size;
+	size_t count;
+	var_t *first;
+	var_t *last;
+	char **envp;
+	size_t envp_size;
+	int changed;
+	char **retired;
+	size_t retired_count;
+	size_t retired_size;
+	size_t generation;
+} env_store_t;
+
+env_store_t *get_env_store(void);
+int init_env(void);
+var_t *find_var(const char *name, size_t name_len);
+var_t *add_var(char *entry, size_t name_len);
+int resize_env_store(env_store_t *store, size_t size);
+void delete_var(var_t *var);
+void retire_entry(char *entry);
+void mark_env_changed(void);
+char **get_envp(void);
+void free_env(void);
+
 /* aliases */
 
 /**
- * struct alias - the blueprint for the built-in alias command
+ * struct alias - an alias defined with the alias builtin
  * @name: the name of the alias
  * @value: the value assigned to the name
- * @next: a pointer to the next alias_t node
+ * @hash: the hash value of the name
+ * @words: the words the alias expands to, with the aliases they start with
+ * expanded too, in a single allocation; NULL until the alias is first used
+ * @generation: the generation of the alias store @words were expanded in
+ * @mark: set while the alias is being expanded, to break cycles
+ * @next: the next alias in the same bucket
+ * @next_alias: the alias defined after this one
+ * @prev_alias: the alias defined before this one
  */
 typedef struct alias
 {
 	char *name;
 	char *value;
+	size_t hash;
+	char **words;
+	size_t generation;
+	size_t mark;
 	struct alias *next;
+	struct alias *next_alias;
+	struct alias *prev_alias;
 } alias_t;
 
-void free_aliases(alias_t **aliases);
-void print_aliases(const alias_t *aliases);
-int unalias(alias_t **aliases, char *command);
-char *get_alias(alias_t *aliases, const char *name);
-int handle_alias(alias_t **aliases, char *command_line);
-int print_alias(const alias_t *aliases, const char *name);
-void parse_aliases(const char *input, alias_t **aliases);
-void build_alias_cmd(char ***sub_command, char *alias_value);
-alias_t *add_alias(alias_t **aliases, const char *name, const char *value);
-void process_non_matching(alias_t *aliases, const char *non_matching, int end);
+/**
+ * struct alias_store - the aliases, indexed by name
+ * @buckets: the buckets of the hash table
+ * @size: the number of buckets, a power of two
+ * @count: the number of aliases
+ * @first: the alias defined first, aliases are printed in definition order
+ * @last: the alias defined last
+ * @generation: incremented whenever an alias is defined or removed, which
+ * invalidates the expansions of all the aliases
+ * @marks: the mark of the expansion in progress
+ */
+typedef struct alias_store
+{
+	alias_t **buckets;
+	size_t size;
+	size_t count;
+	alias_t *first;
+	alias_t *last;
+	size_t generation;
+	size_t marks;
+} alias_store_t;
+
+alias_t *find_alias(const alias_store_t *store, const char *name);
+alias_t *add_alias(alias_store_t *store, const char *name, const char *value);
+void delete_alias(alias_store_t *store, alias_t *alias);
+int resize_alias_store(alias_store_t *store, size_t size);
+void free_aliases(alias_store_t *store);
+void print_aliases(const alias_store_t *store);
+int unalias(alias_store_t *store, char *command);
+int print_alias(const alias_store_t *store, const char *name);
+char **get_alias_words(alias_store_t *store, arena_t *arena, const char *name);
+int handle_alias(alias_store_t *store, char *command_line);
+int parse_aliases(const char *args, alias_store_t *store);
+
+/* remembered command locations */
+
+/**
+ * struct cmd_hash - a remembered command location (the `hash` builtin)
+ * @name: the name of the command as typed by the user
+ * @path: the full path the command was resolved to
+ * @hits: the number of times the remembered path was used
+ * @next: a pointer to the next node in the same bucket
+ */
+typedef struct cmd_hash
+{
+	char *name;
+	char *path;
+	size_t hits;
+	struct cmd_hash *next;
+} cmd_hash_t;
+
+/* background jobs */
+
+/**
+ * struct job - a command running in the background
+ * @id: the job number, as used in %n job specifications
+ * @pgid: the process group ID shared by all the processes of the job
+ * @last_pid: the process ID of the last command of the job
+ * @procs: the number of processes of the job that haven't terminated yet
+ * @state: the state of the job (JOB_RUNNING, JOB_STOPPED or JOB_DONE)
+ * @status: the exit code of the job, valid once the job is done
+ * @command: the command line that started the job
+ * @next: a pointer to the next job
+ *
+ * Description: @procs, @state and @status are updated by the SIGCHLD handler.
+ */
+typedef struct job
+{
+	size_t id;
+	pid_t pgid;
+	pid_t last_pid;
+	volatile sig_atomic_t procs;
+	volatile sig_atomic_t state;
+	volatile sig_atomic_t status;
+	char *command;
+	struct job *next;
+} job_t;
+
+/* lexer */
+
+/**
+ * struct token - a token of a command line
+ * @offset: the offset of the token in the line
+ * @length: the length of the token
+ * @kind: the kind of token (one of the TOK_* macros)
+ */
+typedef struct token
+{
+	size_t offset;
+	size_t length;
+	int kind;
+} token_t;
+
+/**
+ * struct lexer - the token stream of a command line
+ * @line: the command line the tokens point into
+ * @tokens: the tokens, the last one is always a TOK_END token
+ * @count: the number of tokens
+ * @size: the number of tokens @tokens has room for
+ * @pos: the index of the next token to parse
+ */
+typedef struct lexer
+{
+	const char *line;
+	token_t *tokens;
+	size_t count;
+	size_t size;
+	size_t pos;
+} lexer_t;
+
+int lex_line(lexer_t *lexer, const char *line);
+void free_lexer(lexer_t *lexer);
+size_t redir_length(const char *s);
+
+/* command trees */
+
+/**
+ * struct redir - a redirection of a simple command
+ * @fd: the file descriptor being redirected
+ * @type: the kind of redirection (one of the REDIR_* macros)
+ * @target: the word naming the file or the file descriptor to copy, as
+ * written on the command line, or the body of a here-document
+ * @next: the next redirection of the command, they apply in order
+ */
+typedef struct redir
+{
+	int fd;
+	int type;
+	char *target;
+	struct redir *next;
+} redir_t;
+
+/**
+ * struct redirect - the opened redirections of a simple command
+ * @redirs: the redirections, NULL if there are none
+ * @fds: the file descriptors to copy for each of @redirs, -1 to close one
+ * @count: the number of redirections
+ */
+typedef struct redirect
+{
+	redir_t *redirs;
+	int *fds;
+	size_t count;
+} redirect_t;
 
+/**
+ * struct node - a node of a command tree, the parsed form of a command line
+ * @type: the type of the node (one of the NODE_* macros)
+ * @text: the source text of the command, kept for naming jobs (NODE_ASYNC)
+ * and for the BUILTIN_SOURCE builtins (NODE_CMD), else NULL
+ * @words: the words of a simple command, NULL if it has none (NODE_CMD only);
+ * they keep their quotes and are expanded when the command runs
+ * @redirs: the redirections of a simple command, NULL if it has none
+ * (NODE_CMD only)
+ * @left: the first operand of the node
+ * @right: the second operand of the node
+ *
+ * Description: A command line is a chain of NODE_SEQ nodes, one per command,
+ * with the rest of the line on the right. And-or lists are chains too: a
+ * NODE_AND or NODE_OR holds the pipeline before its operator on the left and
+ * the rest of the list on the right. A NODE_PIPE holds a stage of a pipeline
+ * on the left and the rest of the pipeline on the right. A NODE_TIME holds
+ * the command list timed by the `time` keyword on the left, if any.
+ */
+typedef struct node
+{
+	int type;
+	char *text;
+	char **words;
+	redir_t *redirs;
+	struct node *left;
+	struct node *right;
+} node_t;
+
+/* compiled script caches */
+
+/**
+ * struct cache_header - the header of a compiled script cache
+ * @magic: identifies the file as a cache (CACHE_MAGIC)
+ * @version: the version of the cache format (CACHE_VERSION)
+ * @dev: the device of the script
+ * @ino: the inode number of the script
+ * @size: the size of the script
+ * @mtime: the last modification time of the script, in seconds
+ * @mtime_nsec: the nanoseconds part of @mtime
+ * @length: the number of bytes of blocks after the header, those left to load
+ * while the cache is loaded
+ *
+ * Description: A cache is only used when everything but @length matches the
+ * script it is run for.
+ */
+typedef struct cache_header
+{
+	char magic[4];
+	unsigned int version;
+	dev_t dev;
+	ino_t ino;
+	off_t size;
+	time_t mtime;
+	long mtime_nsec;
+	size_t length;
+} cache_header_t;
+
+/**
+ * struct cache_block - the header of a block of compiled commands
+ * @length: the number of bytes of compiled commands after this header
+ * @checksum: the djb2 hash of those bytes
+ *
+ * Description: A block only holds whole lines, about READ_SIZE bytes of
+ * them, so a cache is loaded one block at a time, and the lines of a bad
+ * block can be run from the script instead.
+ */
+typedef struct cache_block
+{
+	size_t length;
+	size_t checksum;
+} cache_block_t;
+
+/**
+ * struct script_cache - a compiled script cache, being loaded or written
+ * @header: the header of the cache
+ * @fd: the file descriptor of the cache being written, else -1
+ * @load_fd: the file descriptor of the cache being loaded, else -1
+ * @script_fd: the file descriptor of the script being compiled
+ * @path: the path of the cache file
+ * @temp_path: the path of the cache being written, renamed to @path once
+ * the whole script was compiled
+ * @buffer: the block of compiled commands being loaded, or the whole lines
+ * waiting to be written to @fd
+ * @size: the size of @buffer
+ * @len: the number of bytes in @buffer
+ * @pos: the position of the next compiled command to load in @buffer
+ * @failed: true if the cache turned out to be unusable
+ */
+typedef struct script_cache
+{
+	cache_header_t header;
+	int fd;
+	int load_fd;
+	int script_fd;
+	char *path;
+	char *temp_path;
+	char *buffer;
+	size_t size;
+	size_t len;
+	size_t pos;
+	int failed;
+} script_cache_t;
 
 /* shell command context */
 
 /**
  * struct shell - a blueprint for the shell
- * @aliases: a list of aliases
+ * @aliases: the aliases
  * @path_list: a list of the PATH directories
  * @line: the command string provided by the user
- * @commands: the inital tokenized commands (splits on semi-colons & newlines)
- * @sub_command: the tokenized version of each command in the commands array
+ * @lexer: the token stream of @line
+ * @tree: the command tree of @line
+ * @arena: the memory of @tree and of everything else @line needs
+ * @sub_command: the words of the simple command being executed, allocated
+ * from @arena
+ * @expansion: the words of @sub_command that were expanded
+ * @target: the expanded target of the redirection being opened, or the
+ * expanded body of a here-document
+ * @redirect: the opened redirections of the simple command being executed
  * @prog_name: the name of we are running
  * @cmd_count: the number of times a command has been executed since the shell
  * started.
- * @tokens: stores multiple tokens before they are further processed
- * @token: a single token
  * @exit_code: the exit code of the last executed program
+ * @interactive: true if the standard input is a terminal
+ * @cmd_table: the table of remembered command locations
+ * @jobs: the table of background jobs
+ * @async: true while the current command is being started in the background
+ * @job_pgid: the process group of the background job being started
+ * @job_command: the command line of the background job being started
+ * @cmd_text: the source text of the simple command being executed, see
+ * BUILTIN_SOURCE
+ * @last_bg_pid: the process ID of the last background command ($!)
+ * @input: the reader of the input the commands are read from
+ * @cache: the compiled cache of the script being run, if any
  */
 typedef struct shell
 {
-	alias_t *aliases;
+	alias_store_t aliases;
 	path_t *path_list;
 	char *line;
-	char **commands;
+	lexer_t lexer;
+	node_t *tree;
+	arena_t arena;
 	char **sub_command;
-	char **tokens;
-	char *token;
+	buffer_t expansion;
+	buffer_t target;
+	redirect_t redirect;
 	const char *prog_name;
 	size_t cmd_count;
 	int exit_code;
+	int interactive;
+	cmd_hash_t *cmd_table[HASH_SIZE];
+	job_t *jobs;
+	int async;
+	pid_t job_pgid;
+	const char *job_command;
+	char *cmd_text;
+	pid_t last_bg_pid;
+	reader_t *input;
+	script_cache_t *cache;
 } shell_t;
 
 shell_t *init_shell(void);
 void sigint_handler(int signum);
+void print_error(shell_t *msh, const char *format, ...);
+void show_prompt(const shell_t *msh);
+void free_prompt(void);
 
 /* builtin handlers */
 
-int _unsetenv(const char *name);
+/**
+ * struct builtin - a builtin command
+ * @name: the name of the builtin
+ * @run: the handler of the builtin, it returns the exit code
+ * @flags: BUILTIN_PIPELINE if the builtin may run in a forked copy of the
+ * shell (a pipeline stage or a background job), BUILTIN_SOURCE if it parses
+ * the command as written rather than its words, BUILTIN_BARE if it is only
+ * a builtin without arguments, the command being left to the external
+ * program of the same name otherwise, and BUILTIN_CAPTURE if it only writes
+ * through stdout and changes nothing in the shell, so a command substitution
+ * may run it without forking
+ */
+typedef struct builtin
+{
+	const char *name;
+	int (*run)(shell_t *msh);
+	int flags;
+} builtin_t;
+
+const builtin_t *find_builtin(const char *name, size_t len);
+const builtin_t *get_builtin(char **words);
+
+int _unsetenv(shell_t *msh, const char *name);
 int handle_cd(shell_t *msh);
-int _setenv(const char *name, const char *value, int overwrite);
-int handle_builtin(shell_t *msh);
+int _setenv(shell_t *msh, const char *name, const char *value,
+		int overwrite);
+int handle_builtin(shell_t *msh, const builtin_t *builtin, node_t *node);
+int _printenv(shell_t *msh);
+int handle_setenv(shell_t *msh);
+int handle_hash(shell_t *msh);
 int handle_exit(shell_t *msh, void (*cleanup)(const char *format, ...));
+const char *get_escape(const char *s, int zero_octal, int *c);
+int handle_echo(shell_t *msh);
+int handle_printf(shell_t *msh);
+int handle_true(shell_t *msh);
+int handle_false(shell_t *msh);
+
+/**
+ * struct test - the arguments of the test builtin being evaluated
+ * @msh: contains all the data relevant to the shell's operation
+ * @args: the arguments of the expression
+ * @pos: the index of the next argument to evaluate
+ * @count: the number of arguments in the expression
+ * @error: true once an error was reported, which ends the evaluation
+ */
+typedef struct test
+{
+	shell_t *msh;
+	char **args;
+	size_t pos;
+	size_t count;
+	int error;
+} test_t;
+
+int handle_test(shell_t *msh);
+int test_expr(test_t *test, int level);
+int test_unary(const char *op, const char *arg);
+int binary_op(const char *op);
+int test_binary(shell_t *msh, const char *left, const char *op,
+		const char *right);
+
+/**
+ * struct parallel - the state of the parallel builtin
+ * @msh: contains all the data relevant to the shell's operation
+ * @pids: the process IDs of the commands running
+ * @jobs: the largest number of commands running at once
+ * @running: the number of commands running
+ * @failed: the number of commands that failed
+ * @in_fd: the file descriptor the commands get as their standard input
+ */
+typedef struct parallel
+{
+	shell_t *msh;
+	pid_t *pids;
+	size_t jobs;
+	size_t running;
+	size_t failed;
+	int in_fd;
+} parallel_t;
+
+int handle_parallel(shell_t *msh);
+void start_parallel(parallel_t *par, char *line);
+void reap_parallel(parallel_t *par);
 
 /* parsers and executors */
 
-char *get_operator(char *str);
-char *handle_comments(char *command);
 int parse_line(shell_t *msh);
+int compile_line(shell_t *msh);
+int build_tree(lexer_t *lexer, arena_t *arena, char *line, node_t **tree);
+node_t *build_command(lexer_t *lexer, arena_t *arena);
+node_t *new_node(arena_t *arena, int type, node_t *left, node_t *right);
+node_t *build_and_or(lexer_t *lexer, arena_t *arena);
+node_t *build_timed(lexer_t *lexer, arena_t *arena);
+node_t *build_pipeline(lexer_t *lexer, arena_t *arena);
+node_t *build_simple(lexer_t *lexer, arena_t *arena);
+int execute_tree(shell_t *msh, node_t *node);
+int run_simple(shell_t *msh, node_t *node);
 int execute_command(const char *pathname, shell_t *msh);
-int parse_and_execute(shell_t *msh, size_t index);
+int spawn_command(shell_t *msh, const char *pathname,
+		posix_spawn_file_actions_t *actions, pid_t *pid);
+int wait_command(pid_t pid);
+int print_spawn_error(shell_t *msh, int error);
 int handle_with_path(shell_t *msh);
 int print_cmd_not_found(shell_t *msh);
 void handle_file_as_input(const char *filename, shell_t *msh);
 char **handle_variables(shell_t *msh);
-int parse(shell_t *msh);
-void parse_helper(shell_t *msh, size_t index);
+size_t get_param(shell_t *msh, const char *name, const char **value,
+		char *buffer);
+size_t braced_length(const char *param);
+const char *expand_text(shell_t *msh, const char *text, char end, int *quoted,
+		int pattern);
+const char *expand_param(shell_t *msh, const char *param, int *quoted);
+const char *substitute_command(shell_t *msh, const char *param);
+void parse_helper(shell_t *msh, node_t *node);
+int search_path(path_t *path_list, const char *name, char *path);
+int find_command(shell_t *msh, const char *name, char *path);
+void expand_alias(shell_t *msh);
+void build_alias_cmd(shell_t *msh, char **alias_words);
+
+/* redirections */
+
+int check_syntax(lexer_t *lexer);
+int add_redir(lexer_t *lexer, arena_t *arena, node_t *node, token_t *token);
+int read_heredocs(shell_t *msh, node_t *node);
+int heredoc_fd(shell_t *msh, redir_t *redir);
+int open_redirs(shell_t *msh, redir_t *redirs, redirect_t *outer);
+void close_redirs(shell_t *msh, redirect_t *outer);
+int apply_redirs(shell_t *msh, int *saved);
+void restore_redirs(shell_t *msh, int *saved);
+void add_redir_actions(shell_t *msh, posix_spawn_file_actions_t *actions);
+
+/* pipelines */
+
+int execute_pipeline(shell_t *msh, node_t *pipeline);
+pid_t start_stage(shell_t *msh, node_t *stage, int in_fd, int out_fd);
+pid_t run_builtin_stage(shell_t *msh, const builtin_t *builtin, node_t *stage,
+		int in_fd, int out_fd);
+int wait_pipeline(pid_t *pids, size_t count, int exit_code);
+
+/* timed commands */
+
+/**
+ * struct cmd_times - what a command list timed with `time` used
+ * @real: the elapsed time, in seconds
+ * @user: the CPU time spent in user mode by the shell and its children, in
+ * seconds
+ * @sys: the CPU time spent in the kernel by the shell and its children, in
+ * seconds
+ * @max_rss: the largest resident set size of the commands, in KiB
+ * @major_faults: the number of page faults that needed I/O
+ * @minor_faults: the number of page faults served without I/O
+ */
+typedef struct cmd_times
+{
+	double real;
+	double user;
+	double sys;
+	long max_rss;
+	long major_faults;
+	long minor_faults;
+} cmd_times_t;
+
+void add_child_usage(const struct rusage *usage);
+int time_command(shell_t *msh, node_t *list);
+
+/* background jobs */
+
+void init_jobs(shell_t *msh);
+void sigchld_handler(int signum);
+void reap_job(job_t *job);
+int add_job(shell_t *msh, pid_t pgid, pid_t last_pid, int procs);
+void remove_job(shell_t *msh, job_t *job);
+job_t *find_job(shell_t *msh, const char *spec);
+void print_job(shell_t *msh, job_t *job);
+void report_jobs(shell_t *msh);
+void block_sigchld(int how, sigset_t *old_mask);
+void free_jobs(shell_t *msh);
+int start_pipeline_job(shell_t *msh, pid_t *pids, size_t count);
+void reset_child_signals(shell_t *msh);
+int handle_jobs(shell_t *msh);
+int handle_wait(shell_t *msh);
+job_t *wait_job(shell_t *msh, job_t *job);
+int handle_fg_bg(shell_t *msh);
+int run_background(shell_t *msh, node_t *node);
+pid_t run_subshell(shell_t *msh, node_t *tree);
+void refresh_path(shell_t *msh);
+
+/* command location table */
+
+char *hash_lookup(shell_t *msh, const char *name);
+cmd_hash_t *hash_insert(shell_t *msh, const char *name, const char *path);
+void hash_reset(shell_t *msh);
+void print_hash(shell_t *msh);
+
+/* compiled script caches */
+
+char *cache_path(const char *filename);
+int set_cache_key(cache_header_t *header, int fd);
+int cache_matches(const cache_header_t *header, int fd);
+script_cache_t *load_cache(const char *filename, int script_fd);
+void free_cache(script_cache_t **cache);
+void put_bytes(script_cache_t *cache, const void *data, size_t n);
+void put_number(script_cache_t *cache, size_t n);
+void put_string(script_cache_t *cache, const char *str);
+void put_node(script_cache_t *cache, node_t *node);
+void finish_cache(shell_t *msh);
+void put_block(script_cache_t *cache);
+int get_block(script_cache_t *cache);
+int read_full(int fd, void *buffer, size_t n);
+int get_bytes(script_cache_t *cache, void *dest, size_t n);
+int get_number(script_cache_t *cache, size_t *n);
+char *get_string(script_cache_t *cache, arena_t *arena);
+node_t *get_node(script_cache_t *cache, arena_t *arena);
+void put_redirs(script_cache_t *cache, redir_t *redir);
+redir_t *get_redirs(script_cache_t *cache, arena_t *arena);
+void run_script(shell_t *msh, const char *filename, int fd, size_t skip);
+void run_cache(shell_t *msh, const char *filename);
+void start_cache(shell_t *msh, const char *filename, int script_fd);
 
 #endif /* SHELL_H */
@@ -0,0 +1,148 @@
+#include "shell.h"
+
+/**
+ * spawn_command - starts a program in a new process without waiting for it
+ * @msh: the shell's context, msh->sub_command holds the arguments to pass
+ * @pathname: the absolute path to the binary file to execute
+ * @actions: the file actions (e.g. dup2) to apply in the new process, or NULL
+ * @pid: where to store the process ID of the new process
+ *
+ * Description: The program is started with posix_spawn(), which the C library
+ * implements with clone(CLONE_VM | CLONE_VFORK). Unlike fork(), the shell's
+ * memory is not duplicated, so the cost of starting a command does not grow
+ * with the size of the shell's heap. Building with -DMSH_FORK_EXEC switches
+ * back to the classic fork() and execve() for comparison purposes, in which
+ * case the redirections in msh->redirect are applied by the child instead of
+ * through @actions, see add_redir_actions().
+ * Background commands are put in the process group msh->job_pgid (0 means
+ * a new group led by the command itself).
+ *
+ * Return: 0 on success, else the error number describing the failure
+ */
+int spawn_command(shell_t *msh, const char *pathname,
+		posix_spawn_file_actions_t *actions, pid_t *pid)
+{
+#ifdef MSH_FORK_EXEC
+	(void)actions;
+	*pid = fork();
+	if (*pid == -1)
+		return (errno);
+	if (*pid == 0)
+	{
+		if (msh->async)
+			setpgid(0, msh->job_pgid);
+		if (apply_redirs(msh, NULL) == -1)
+			_exit(1);
+		execve(pathname, msh->sub_command, get_envp());
+		_exit(errno == ENOENT ? CMD_NOT_FOUND : 126);
+	}
+	if (msh->async)
+		setpgid(*pid, msh->job_pgid);
+	return (0);
+#else
+	int error;
+	posix_spawnattr_t attr;
+
+	posix_spawnattr_init(&attr);
+	if (msh->async)
+	{
+		posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETPGROUP);
+		posix_spawnattr_setpgroup(&attr, msh->job_pgid);
+	}
+	error = posix_spawn(pid, pathname, actions, &attr, msh->sub_command,
+			get_envp());
+	posix_spawnattr_destroy(&attr);
+
+	return (error);
+#endif
+}
+
+/**
+ * wait_command - waits for a process to terminate
+ * @pid: the process ID to wait for
+ *
+ * Description: The resources the process used are counted for the `time`
+ * keyword, see time_command().
+ *
+ * Return: the exit code of the process, 128 plus the signal number if it was
+ * terminated by a signal, else -1 if waiting failed
+ */
+int wait_command(pid_t pid)
+{
+	struct rusage usage;
+	int status;
+
+	while (wait4(pid, &status, 0, &usage) == -1)
+	{
+		if (errno != EINTR)
+		{
+			perror("wait");
+			return (-1);
+		}
+	}
+	add_child_usage(&usage);
+
+	if (WIFEXITED(status))
+		return (WEXITSTATUS(status));
+	if (WIFSIGNALED(status))
+		return (128 + WTERMSIG(status));
+
+	return (0);
+}
+
+/**
+ * print_spawn_error - reports why a program could not be started
+ * @msh: the shell's context
+ * @error: the error number returned when starting the program
+ *
+ * Return: 126 if the program was found but could not be executed, else -1
+ * so that the caller reports the command as not found
+ */
+int print_spawn_error(shell_t *msh, int error)
+{
+	if (error == ENOENT)
+		return (-1);
+
+	print_error(msh, "%s: %s\n", msh->sub_command[0], strerror(error));
+
+	return (126);
+}
+
+/**
+ * reset_child_signals - prepares a forked copy of the shell to run commands
+ * on its own
+ * @msh: the shell's context
+ *
+ * Description: The jobs and the script cache being written belong to the
+ * parent shell, the child must neither touch them nor free them.
+ */
+void reset_child_signals(shell_t *msh)
+{
+	signal(SIGCHLD, SIG_DFL);
+	msh->jobs = NULL;
+	msh->async = 0;
+	msh->cache = NULL;
+}
+
+/**
+ * add_redir_actions - adds the redirections opened by open_redirs() to the
+ * file actions of a program about to be spawned
+ * @msh: the shell's context
+ * @actions: the file actions
+ *
+ * Description: The file actions run in the new process between its creation
+ * and the execution of the program, so the shell's own file descriptors are
+ * left alone.
+ */
+void add_redir_actions(shell_t *msh, posix_spawn_file_actions_t *actions)
+{
+	redir_t *redir = msh->redirect.redirs;
+	size_t i;
+
+	for (i = 0; i < msh->redirect.count; i++, redir = redir->next)
+		if (msh->redirect.fds[i] == -1)
+			posix_spawn_file_actions_addclose(actions, redir->fd);
+		else
+			posix_spawn_file_actions_adddup2(actions, msh->redirect.fds[i],
+					redir->fd);
+}
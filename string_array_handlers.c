@@ -1,68 +1,138 @@
 #include "shell.h"
 
 /**
- * duplicate_str_array - duplicate a string array
- * @original: the original string
+ * copy_words - copies the pointers of two string arrays into a single one
+ * allocated from an arena, the strings themselves are shared
+ * @arena: the arena to allocate the array from
+ * @words: the first string array, can be NULL
+ * @rest: the string array to append to @words, can be NULL
  *
- * Return: the duplicate string on success, else NULL if it fails
+ * Return: the new string array, else NULL on failure
  */
-char **duplicate_str_array(char **original)
+char **copy_words(arena_t *arena, char **words, char **rest)
 {
-	size_t size, i;
-	char **duplicate;
+	size_t count = 0, extra = 0, i;
+	char **copy;
 
-	if (original == NULL)
+	while (words != NULL && words[count] != NULL)
+		count++;
+	while (rest != NULL && rest[extra] != NULL)
+		extra++;
+
+	copy = arena_alloc(arena, sizeof(char *) * (count + extra + 1));
+	if (copy == NULL)
 		return (NULL);
 
-	size = 0;
-	while (original[size] != NULL)
-		size++;
+	for (i = 0; i < count; i++)
+		copy[i] = words[i];
+	for (i = 0; i < extra; i++)
+		copy[count + i] = rest[i];
+	copy[count + extra] = NULL;
 
-	duplicate = malloc((size + 1) * sizeof(char *));
-	if (duplicate == NULL)
-		return (NULL);
+	return (copy);
+}
 
-	for (i = 0; i < size; i++)
+/**
+ * word_end - finds the end of the word starting a string
+ * @word: the start of the word
+ *
+ * Description: Blanks inside quotes, ${...} expansions or $(...) command
+ * substitutions, or escaped with a
+ * backslash, don't end the word.
+ *
+ * Return: a pointer past the last character of the word
+ */
+static const char *word_end(const char *word)
+{
+	char quote = '\0';
+	size_t len;
+
+	for (; *word != '\0'; word++)
 	{
-		duplicate[i] = _strdup(original[i]);
-		if (duplicate[i] == NULL)
-		{
-			free_str(&duplicate);
-			return (NULL);
-		}
+		if (quote == '\0' && (isblank(*word) || *word == '\n'))
+			break;
+		if (*word == '\\' && quote != '\'' && word[1] != '\0')
+			word++;
+		else if (quote != '\'' && isbraced(word) &&
+				(len = braced_length(word)) > 0)
+			word += len - 1;
+		else if (*word == quote)
+			quote = '\0';
+		else if (quote == '\0' && isquote(*word))
+			quote = *word;
 	}
-	duplicate[size] = NULL;
 
-	return (duplicate);
+	return (word);
 }
 
 /**
- * concatenate_arrays - appends the contents of one string array to another
- * @dest: a pointer to the destination string array
- * @src: the source string array (where to copy from)
+ * split_words - splits a string into words separated by blanks, in an arena
+ * @arena: the arena to allocate the words and their array from
+ * @str: the string to split
+ *
+ * Description: The words keep their quotes, like the words of a command
+ * line.
+ *
+ * Return: the NULL-terminated array of words, else NULL on failure
  */
-void concatenate_arrays(char ***dest, char **src)
+char **split_words(arena_t *arena, const char *str)
 {
-	int i, src_length = 0, dest_length = 0;
+	size_t count = 0, i;
+	const char *s, *end;
+	char **words;
 
-	if (src == NULL)
-		return; /* there's nothing concatenate */
+	for (s = str; *s != '\0'; s = end, count++)
+	{
+		while (isblank(*s) || *s == '\n')
+			s++;
+		if (*s == '\0')
+			break;
+		end = word_end(s);
+	}
+
+	words = arena_alloc(arena, sizeof(char *) * (count + 1));
+	for (i = 0, s = str; words != NULL && i < count; i++, s = end)
+	{
+		while (isblank(*s) || *s == '\n')
+			s++;
+		end = word_end(s);
+		words[i] = arena_strndup(arena, s, end - s);
+		if (words[i] == NULL)
+			return (NULL);
+	}
+	if (words != NULL)
+		words[count] = NULL;
+
+	return (words);
+}
 
-	while ((*dest)[dest_length] != NULL)
-		dest_length++;
+/**
+ * pack_words - copies a string array and its strings into a single block of
+ * memory, which a single free() releases
+ * @words: the string array
+ *
+ * Return: the copy, else NULL if memory allocation failed
+ */
+char **pack_words(char **words)
+{
+	size_t count, size = 0, len, i;
+	char **copy, *str;
 
-	while (src[src_length] != NULL)
-		src_length++;
+	for (count = 0; words[count] != NULL; count++)
+		size += _strlen(words[count]) + 1;
 
-	*dest = realloc(*dest, (dest_length + src_length + 1) * sizeof(char *));
-	if (*dest == NULL)
-		return; /* memory allocation failed */
+	copy = malloc(sizeof(char *) * (count + 1) + size);
+	if (copy == NULL)
+		return (NULL);
 
-	for (i = 0; i < src_length; i++)
+	str = (char *)(copy + count + 1);
+	for (i = 0; i < count; i++)
 	{
-		(*dest)[dest_length + i] = _strdup(src[i]);
+		len = _strlen(words[i]) + 1;
+		copy[i] = _memcpy(str, words[i], len);
+		str += len;
 	}
+	copy[count] = NULL;
 
-	/* null terminate the string array */
-	(*dest)[dest_length + src_length] = NULL;
+	return (copy);
 }
@@ -0,0 +1,156 @@
+#include "shell.h"
+
+#ifdef MSH_X86
+
+#include <immintrin.h>
+
+/*
+ * AVX2 versions of the string primitives, see init_string_ops(). They work
+ * like the SSE2 ones, 32 bytes at a time. Comparing strings is left to
+ * strcmp_sse2(), since the strings compared are mostly short names.
+ */
+
+#define AVX2 __attribute__((target("avx2"), no_sanitize_address))
+
+/**
+ * strlen_avx2 - returns the length of a string
+ * @s: the string, can be NULL
+ *
+ * Return: the length of the string
+ */
+AVX2 size_t strlen_avx2(const char *s)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	size_t offset = (size_t)s & 31;
+	const char *p = s - offset;
+	unsigned int mask;
+
+	if (s == NULL)
+		return (0);
+
+	mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(
+				_mm256_load_si256((const __m256i *)p), zero)) >> offset;
+	while (mask == 0)
+	{
+		p += 32;
+		offset = 0;
+		mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(
+					_mm256_load_si256((const __m256i *)p), zero));
+	}
+
+	return (p + offset + __builtin_ctz(mask) - s);
+}
+
+/**
+ * strchr_avx2 - locates a character in a string
+ * @s: the string, can be NULL
+ * @c: the character
+ *
+ * Return: a pointer to the first occurrence of @c in @s, which is the null
+ * byte if @c is 0, else NULL if it isn't found
+ */
+AVX2 char *strchr_avx2(const char *s, int c)
+{
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i chr = _mm256_set1_epi8((char)c);
+	size_t offset = (size_t)s & 31;
+	const char *p = s - offset;
+	unsigned int mask;
+	__m256i block;
+
+	if (s == NULL)
+		return (NULL);
+
+	block = _mm256_load_si256((const __m256i *)p);
+	mask = (unsigned int)_mm256_movemask_epi8(_mm256_or_si256(
+				_mm256_cmpeq_epi8(block, zero),
+				_mm256_cmpeq_epi8(block, chr))) >> offset;
+	while (mask == 0)
+	{
+		p += 32;
+		offset = 0;
+		block = _mm256_load_si256((const __m256i *)p);
+		mask = _mm256_movemask_epi8(_mm256_or_si256(
+					_mm256_cmpeq_epi8(block, zero),
+					_mm256_cmpeq_epi8(block, chr)));
+	}
+	p += offset + __builtin_ctz(mask);
+
+	return ((*p == (char)c) ? (char *)p : NULL);
+}
+
+/**
+ * memcpy_avx2 - copies a memory area
+ * @dest: the destination, it must not overlap @src
+ * @src: the source
+ * @n: the number of bytes to copy
+ *
+ * Return: @dest
+ */
+AVX2 void *memcpy_avx2(void *dest, const void *src, size_t n)
+{
+	char *d = dest;
+	const char *s = src;
+
+	for (; n >= 128; n -= 128, d += 128, s += 128)
+	{
+		_mm256_storeu_si256((__m256i *)d,
+				_mm256_loadu_si256((const __m256i *)s));
+		_mm256_storeu_si256((__m256i *)(d + 32),
+				_mm256_loadu_si256((const __m256i *)(s + 32)));
+		_mm256_storeu_si256((__m256i *)(d + 64),
+				_mm256_loadu_si256((const __m256i *)(s + 64)));
+		_mm256_storeu_si256((__m256i *)(d + 96),
+				_mm256_loadu_si256((const __m256i *)(s + 96)));
+	}
+	for (; n >= 32; n -= 32, d += 32, s += 32)
+		_mm256_storeu_si256((__m256i *)d,
+				_mm256_loadu_si256((const __m256i *)s));
+	for (; n >= 16; n -= 16, d += 16, s += 16)
+		_mm_storeu_si128((__m128i *)d, _mm_loadu_si128((const __m128i *)s));
+	while (n-- > 0)
+		*d++ = *s++;
+
+	return (dest);
+}
+
+/**
+ * span_avx2 - returns the length of the prefix of a string made of bytes
+ * that are, or are not, part of a set
+ * @s: the string
+ * @set: the set of bytes, sets of more than SPAN_SET_MAX bytes are left to
+ * span_scalar()
+ * @in_set: true to count the bytes found in @set, false to count the others
+ *
+ * Return: the length of the prefix
+ */
+AVX2 size_t span_avx2(const char *s, const char *set, int in_set)
+{
+	__m256i bytes[SPAN_SET_MAX], block, found;
+	size_t offset = (size_t)s & 31, count, i;
+	const char *p = s - offset;
+	unsigned int mask;
+
+	for (count = 0; set[count] != '\0' && count < SPAN_SET_MAX; count++)
+		bytes[count] = _mm256_set1_epi8(set[count]);
+	if (set[count] != '\0')
+		return (span_scalar(s, set, in_set));
+
+	while (1)
+	{
+		block = _mm256_load_si256((const __m256i *)p);
+		found = _mm256_setzero_si256();
+		for (i = 0; i < count; i++)
+			found = _mm256_or_si256(found, _mm256_cmpeq_epi8(block, bytes[i]));
+		mask = _mm256_movemask_epi8(found);
+		mask = ((in_set) ? ~mask : mask) | (unsigned int)_mm256_movemask_epi8(
+				_mm256_cmpeq_epi8(block, _mm256_setzero_si256()));
+		mask >>= offset;
+		if (mask != 0)
+			return (p + offset + __builtin_ctz(mask) - s);
+		p += 32;
+		offset = 0;
+	}
+}
+
+#endif /* MSH_X86 */
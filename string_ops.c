@@ -0,0 +1,71 @@
+#include "shell.h"
+
+/*
+ * The string primitives on the hot paths are called through these pointers,
+ * which init_string_ops() points at the fastest versions the CPU supports.
+ * Until then, and on CPUs without SSE2, the scalar versions are used.
+ */
+size_t (*_strlen)(const char *s) = strlen_scalar;
+char *(*_strchr)(const char *s, int c) = strchr_scalar;
+int (*_strcmp)(const char *s1, const char *s2) = strcmp_scalar;
+void *(*_memcpy)(void *dest, const void *src, size_t n) = memcpy_scalar;
+size_t (*string_span)(const char *s, const char *set, int in_set) =
+	span_scalar;
+
+/**
+ * span_scalar - returns the length of the prefix of a string made of bytes
+ * that are, or are not, part of a set
+ * @s: the string
+ * @set: the set of bytes
+ * @in_set: true to count the bytes found in @set (strspn), false to count
+ * the bytes not found in it (strcspn)
+ *
+ * Return: the length of the prefix
+ */
+size_t span_scalar(const char *s, const char *set, int in_set)
+{
+	unsigned char map[256] = {0};
+	size_t i;
+
+	for (i = 0; set[i] != '\0'; i++)
+		map[(unsigned char)set[i]] = 1;
+
+	for (i = 0; s[i] != '\0' && map[(unsigned char)s[i]] == !!in_set; i++)
+		;
+
+	return (i);
+}
+
+/**
+ * init_string_ops - picks the versions of the string primitives to use,
+ * based on what the CPU supports (as reported by the cpuid instruction)
+ *
+ * Description: Setting MSH_STRING_OPS to "scalar", "sse2" or "avx2" limits
+ * the choice, to compare them.
+ */
+void init_string_ops(void)
+{
+#ifdef MSH_X86
+	const char *limit = getenv("MSH_STRING_OPS");
+
+	if (limit != NULL && !_strcmp(limit, "scalar"))
+		return;
+
+	__builtin_cpu_init();
+	if (!__builtin_cpu_supports("sse2"))
+		return;
+	_strlen = strlen_sse2;
+	_strchr = strchr_sse2;
+	_strcmp = strcmp_sse2;
+	_memcpy = memcpy_sse2;
+	string_span = span_sse2;
+
+	if ((limit != NULL && !_strcmp(limit, "sse2")) ||
+			!__builtin_cpu_supports("avx2"))
+		return;
+	_strlen = strlen_avx2;
+	_strchr = strchr_avx2;
+	_memcpy = memcpy_avx2;
+	string_span = span_avx2;
+#endif /* MSH_X86 */
+}
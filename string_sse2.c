@@ -0,0 +1,191 @@
+#include "shell.h"
+
+#ifdef MSH_X86
+
+#include <emmintrin.h>
+
+/*
+ * SSE2 versions of the string primitives, see init_string_ops(). Strings are
+ * scanned 16 bytes at a time with aligned loads, which never cross a page
+ * boundary, so reading past the end of a string is harmless. AddressSanitizer
+ * doesn't know that, so these functions aren't instrumented.
+ */
+
+#define SSE2 __attribute__((target("sse2"), no_sanitize_address))
+
+/**
+ * strlen_sse2 - returns the length of a string
+ * @s: the string, can be NULL
+ *
+ * Return: the length of the string
+ */
+SSE2 size_t strlen_sse2(const char *s)
+{
+	const __m128i zero = _mm_setzero_si128();
+	size_t offset = (size_t)s & 15;
+	const char *p = s - offset;
+	unsigned int mask;
+
+	if (s == NULL)
+		return (0);
+
+	mask = _mm_movemask_epi8(_mm_cmpeq_epi8(
+				_mm_load_si128((const __m128i *)p), zero)) >> offset;
+	while (mask == 0)
+	{
+		p += 16;
+		offset = 0;
+		mask = _mm_movemask_epi8(_mm_cmpeq_epi8(
+					_mm_load_si128((const __m128i *)p), zero));
+	}
+
+	return (p + offset + __builtin_ctz(mask) - s);
+}
+
+/**
+ * strchr_sse2 - locates a character in a string
+ * @s: the string, can be NULL
+ * @c: the character
+ *
+ * Return: a pointer to the first occurrence of @c in @s, which is the null
+ * byte if @c is 0, else NULL if it isn't found
+ */
+SSE2 char *strchr_sse2(const char *s, int c)
+{
+	const __m128i zero = _mm_setzero_si128(), chr = _mm_set1_epi8((char)c);
+	size_t offset = (size_t)s & 15;
+	const char *p = s - offset;
+	unsigned int mask;
+	__m128i block;
+
+	if (s == NULL)
+		return (NULL);
+
+	block = _mm_load_si128((const __m128i *)p);
+	mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, zero),
+				_mm_cmpeq_epi8(block, chr))) >> offset;
+	while (mask == 0)
+	{
+		p += 16;
+		offset = 0;
+		block = _mm_load_si128((const __m128i *)p);
+		mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, zero),
+					_mm_cmpeq_epi8(block, chr)));
+	}
+	p += offset + __builtin_ctz(mask);
+
+	return ((*p == (char)c) ? (char *)p : NULL);
+}
+
+/**
+ * strcmp_sse2 - compares two strings
+ * @s1: the first string
+ * @s2: the second string
+ *
+ * Description: The strings are compared 16 bytes at a time with unaligned
+ * loads, as long as neither load could cross into the next page.
+ *
+ * Return: 0 if the strings are equal, else the difference between the first
+ * two bytes that differ
+ */
+SSE2 int strcmp_sse2(const char *s1, const char *s2)
+{
+	const __m128i zero = _mm_setzero_si128();
+	unsigned int mask;
+	__m128i a;
+	size_t i = 0;
+
+	while (1)
+	{
+		if (((size_t)(s1 + i) & 4095) > 4080 ||
+				((size_t)(s2 + i) & 4095) > 4080)
+		{
+			if (s1[i] != s2[i] || s1[i] == '\0')
+				return (s1[i] - s2[i]);
+			i++;
+			continue;
+		}
+		a = _mm_loadu_si128((const __m128i *)(s1 + i));
+		mask = (~_mm_movemask_epi8(_mm_cmpeq_epi8(a,
+						_mm_loadu_si128((const __m128i *)(s2 + i)))) & 0xffff) |
+			_mm_movemask_epi8(_mm_cmpeq_epi8(a, zero));
+		if (mask != 0)
+		{
+			i += __builtin_ctz(mask);
+			return (s1[i] - s2[i]);
+		}
+		i += 16;
+	}
+}
+
+/**
+ * memcpy_sse2 - copies a memory area
+ * @dest: the destination, it must not overlap @src
+ * @src: the source
+ * @n: the number of bytes to copy
+ *
+ * Return: @dest
+ */
+SSE2 void *memcpy_sse2(void *dest, const void *src, size_t n)
+{
+	char *d = dest;
+	const char *s = src;
+
+	for (; n >= 64; n -= 64, d += 64, s += 64)
+	{
+		_mm_storeu_si128((__m128i *)d, _mm_loadu_si128((const __m128i *)s));
+		_mm_storeu_si128((__m128i *)(d + 16),
+				_mm_loadu_si128((const __m128i *)(s + 16)));
+		_mm_storeu_si128((__m128i *)(d + 32),
+				_mm_loadu_si128((const __m128i *)(s + 32)));
+		_mm_storeu_si128((__m128i *)(d + 48),
+				_mm_loadu_si128((const __m128i *)(s + 48)));
+	}
+	for (; n >= 16; n -= 16, d += 16, s += 16)
+		_mm_storeu_si128((__m128i *)d, _mm_loadu_si128((const __m128i *)s));
+	while (n-- > 0)
+		*d++ = *s++;
+
+	return (dest);
+}
+
+/**
+ * span_sse2 - returns the length of the prefix of a string made of bytes
+ * that are, or are not, part of a set
+ * @s: the string
+ * @set: the set of bytes, sets of more than SPAN_SET_MAX bytes are left to
+ * span_scalar()
+ * @in_set: true to count the bytes found in @set, false to count the others
+ *
+ * Return: the length of the prefix
+ */
+SSE2 size_t span_sse2(const char *s, const char *set, int in_set)
+{
+	__m128i bytes[SPAN_SET_MAX], block, found;
+	size_t offset = (size_t)s & 15, count, i;
+	const char *p = s - offset;
+	unsigned int mask;
+
+	for (count = 0; set[count] != '\0' && count < SPAN_SET_MAX; count++)
+		bytes[count] = _mm_set1_epi8(set[count]);
+	if (set[count] != '\0')
+		return (span_scalar(s, set, in_set));
+
+	while (1)
+	{
+		block = _mm_load_si128((const __m128i *)p);
+		found = _mm_setzero_si128();
+		for (i = 0; i < count; i++)
+			found = _mm_or_si128(found, _mm_cmpeq_epi8(block, bytes[i]));
+		mask = _mm_movemask_epi8(found);
+		mask = ((in_set) ? ~mask & 0xffff : mask) | _mm_movemask_epi8(
+				_mm_cmpeq_epi8(block, _mm_setzero_si128()));
+		mask >>= offset;
+		if (mask != 0)
+			return (p + offset + __builtin_ctz(mask) - s);
+		p += 16;
+		offset = 0;
+	}
+}
+
+#endif /* MSH_X86 */
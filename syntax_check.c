@@ -0,0 +1,49 @@
+#include "shell.h"
+
+/**
+ * check_syntax - checks that every redirection of a token stream is
+ * followed by its target, and that every operator has its commands
+ * @lexer: the token stream
+ *
+ * Description: `|`, `&&` and `||` need a command on both sides, and `&` one
+ * before it, where a command is a word or a redirection. The whole line is
+ * checked before anything is built, so nothing on a line with a syntax error
+ * runs. Empty commands between `;` are left alone.
+ *
+ * Return: 0 if the line is well formed, else 2, with @lexer positioned at the
+ * unexpected token
+ */
+int check_syntax(lexer_t *lexer)
+{
+	token_t *tokens = lexer->tokens;
+	size_t i;
+	int command = 0, operand = 0, kind;
+
+	for (i = 0; i < lexer->count; i++)
+	{
+		kind = tokens[i].kind;
+		if (kind == TOK_REDIR && tokens[i + 1].kind != TOK_WORD)
+		{
+			i++; /* the target is missing */
+			break;
+		}
+		if (kind == TOK_WORD || kind == TOK_REDIR)
+		{
+			i += (kind == TOK_REDIR); /* past the target */
+			command = 1;
+			operand = 0;
+			continue;
+		}
+		if ((kind == TOK_SEMI || kind == TOK_END) ? operand : !command)
+			break;
+		operand = (kind == TOK_PIPE || kind == TOK_AND ||
+				kind == TOK_OR);
+		command = 0;
+	}
+	if (i >= lexer->count)
+		return (0);
+
+	lexer->pos = i;
+
+	return (2);
+}
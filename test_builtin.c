@@ -0,0 +1,165 @@
+#include "shell.h"
+
+/**
+ * test_error - reports an error of the test builtin
+ * @test: the expression being evaluated
+ * @arg: the argument at fault, NULL if there is none
+ * @message: the error message
+ *
+ * Return: always 2, the exit code of test on errors
+ */
+static int test_error(test_t *test, const char *arg, const char *message)
+{
+	shell_t *msh = test->msh;
+
+	if (arg != NULL)
+		print_error(msh, "%s: %s: %s\n", msh->sub_command[0], arg, message);
+	else
+		print_error(msh, "%s: %s\n", msh->sub_command[0], message);
+	test->error = 1;
+
+	return (2);
+}
+
+/**
+ * test_primary - evaluates a primary of a test expression: `! primary`,
+ * `( expression )`, `arg op arg`, `op arg` or `arg`
+ * @test: the expression, positioned at the primary
+ *
+ * Return: 0 if it is true, 1 if it is false, else 2 on errors
+ */
+static int test_primary(test_t *test)
+{
+	char **args = test->args + test->pos;
+	size_t left = test->count - test->pos;
+	int result;
+
+	if (left == 0)
+		return (test_error(test, NULL, "argument expected"));
+	test->pos++;
+	if (left >= 3 && binary_op(args[1]) != -1)
+	{
+		test->pos += 2;
+		return (test_binary(test->msh, args[0], args[1], args[2]));
+	}
+	if (!_strcmp(args[0], "!"))
+		return ((result = test_primary(test)) == 2 ? 2 : !result);
+	if (!_strcmp(args[0], "(") && left > 1)
+	{
+		result = test_expr(test, 0);
+		if (test->pos == test->count || _strcmp(test->args[test->pos], ")"))
+			return (test_error(test, NULL, "closing paren expected"));
+		test->pos++;
+		return (result);
+	}
+
+	if (left >= 2 && (result = test_unary(args[0], args[1])) != -1)
+	{
+		test->pos++;
+		return (result);
+	}
+
+	return (*args[0] == '\0');
+}
+
+/**
+ * test_expr - evaluates a test expression, with the -o operator binding
+ * less tightly than -a
+ * @test: the expression, positioned at its start
+ * @level: 0 to evaluate `and -o and ...`, 1 for `primary -a primary ...`
+ *
+ * Return: 0 if it is true, 1 if it is false, else 2 on errors
+ */
+int test_expr(test_t *test, int level)
+{
+	int result = (level == 0) ? test_expr(test, 1) : test_primary(test), next;
+	const char *op = (level == 0) ? "-o" : "-a";
+
+	while (!test->error && test->pos < test->count &&
+			!_strcmp(test->args[test->pos], op))
+	{
+		test->pos++;
+		next = (level == 0) ? test_expr(test, 1) : test_primary(test);
+		if (level == 0)
+			result = (result == 0 || next == 0) ? 0 : 1;
+		else
+			result = (result == 0 && next == 0) ? 0 : 1;
+	}
+
+	return ((test->error) ? 2 : result);
+}
+
+/**
+ * test_args - evaluates test arguments the way POSIX specifies for up to 4
+ * arguments, where an argument is only an operator if the count allows it
+ * @test: the arguments
+ *
+ * Description: With more arguments, the expression is parsed with -a, -o
+ * and parentheses.
+ *
+ * Return: 0 if the expression is true, 1 if it is false, else 2 on errors
+ */
+static int test_args(test_t *test)
+{
+	char **args = test->args;
+	int result;
+
+	if (test->count == 0)
+		return (1);
+	if (test->count == 1)
+		return (*args[0] == '\0');
+	if (test->count < 5 && !_strcmp(args[0], "!") &&
+			(test->count != 3 || binary_op(args[1]) == -1))
+	{
+		test->args++;
+		test->count--;
+		result = test_args(test);
+		return ((result == 2) ? 2 : !result);
+	}
+	if (test->count == 2 && (result = test_unary(args[0], args[1])) == -1)
+		return (test_error(test, args[0], "unexpected operator"));
+	if (test->count == 2)
+		return (result);
+	if ((test->count == 3 || test->count == 4) && !_strcmp(args[0], "(") &&
+			!_strcmp(args[test->count - 1], ")") &&
+			(test->count == 4 || binary_op(args[1]) == -1))
+	{
+		test->args++;
+		test->count -= 2;
+		return (test_args(test));
+	}
+
+	result = test_expr(test, 0);
+	if (!test->error && test->pos < test->count)
+		return (test_error(test, test->args[test->pos], "unexpected operator"));
+
+	return (result);
+}
+
+/**
+ * handle_test - handles the builtin `test` and `[` commands
+ * @msh: contains all the data relevant to the shell's operation
+ *
+ * Description: `[` needs a last argument of `]`, which isn't part of the
+ * expression.
+ *
+ * Return: 0 if the expression is true, 1 if it is false, else 2 on errors
+ */
+int handle_test(shell_t *msh)
+{
+	test_t test;
+
+	test.msh = msh;
+	test.args = msh->sub_command + 1;
+	test.pos = test.error = 0;
+	for (test.count = 0; test.args[test.count] != NULL; test.count++)
+		;
+	if (!_strcmp(msh->sub_command[0], "["))
+	{
+		if (test.count == 0 || _strcmp(test.args[test.count - 1], "]"))
+			return (test_error(&test, NULL, "missing ]"));
+		test.count--;
+	}
+
+	return (test_args(&test));
+}
@@ -0,0 +1,165 @@
+#include "shell.h"
+
+/**
+ * test_file - evaluates a unary file operator of the test builtin
+ * @op: the operator character, e.g. 'f' for -f
+ * @path: the path of the file
+ *
+ * Return: 0 if the test is true, else 1
+ */
+static int test_file(char op, const char *path)
+{
+	struct stat info;
+
+	if (op == 'h' || op == 'L')
+		return (lstat(path, &info) == -1 || !S_ISLNK(info.st_mode));
+	if (op == 'r' || op == 'w' || op == 'x')
+		return (access(path, (op == 'r') ? R_OK : (op == 'w') ? W_OK : X_OK)
+				!= 0);
+	if (stat(path, &info) == -1)
+		return (1);
+
+	switch (op)
+	{
+	case 'b':
+		return (!S_ISBLK(info.st_mode));
+	case 'c':
+		return (!S_ISCHR(info.st_mode));
+	case 'd':
+		return (!S_ISDIR(info.st_mode));
+	case 'f':
+		return (!S_ISREG(info.st_mode));
+	case 'g':
+		return (!(info.st_mode & S_ISGID));
+	case 'p':
+		return (!S_ISFIFO(info.st_mode));
+	case 'S':
+		return (!S_ISSOCK(info.st_mode));
+	case 's':
+		return (info.st_size == 0);
+	case 'u':
+		return (!(info.st_mode & S_ISUID));
+	}
+
+	return (0); /* -e */
+}
+
+/**
+ * test_unary - evaluates a unary operator of the test builtin
+ * @op: the operator, e.g. "-f"
+ * @arg: its operand
+ *
+ * Return: 0 if the test is true, 1 if it is false, else -1 if @op isn't a
+ * unary operator
+ */
+int test_unary(const char *op, const char *arg)
+{
+	if (op[0] != '-' || op[1] == '\0' || op[2] != '\0' ||
+			_strchr("bcdefghLnprSstuwxz", op[1]) == NULL)
+		return (-1);
+
+	if (op[1] == 'n' || op[1] == 'z')
+		return ((*arg == '\0') == (op[1] == 'n'));
+	if (op[1] == 't')
+		return (!isatty(_atoi(arg)));
+
+	return (test_file(op[1], arg));
+}
+
+/**
+ * test_files - evaluates the -ef, -nt and -ot operators of the test builtin
+ * @left: the path of the first file
+ * @op: the operator character, 'e', 'n' or 'o'
+ * @right: the path of the second file
+ *
+ * Description: A file that exists is newer than one that doesn't.
+ *
+ * Return: 0 if the test is true, else 1
+ */
+static int test_files(const char *left, char op, const char *right)
+{
+	struct stat first, second;
+	int has_first = (stat(left, &first) == 0);
+	int has_second = (stat(right, &second) == 0), newer;
+
+	if (op == 'e')
+		return (!(has_first && has_second && first.st_dev == second.st_dev &&
+					first.st_ino == second.st_ino));
+	if (!has_first || !has_second)
+		newer = has_first - has_second;
+	else if (first.st_mtim.tv_sec != second.st_mtim.tv_sec)
+		newer = (first.st_mtim.tv_sec > second.st_mtim.tv_sec) ? 1 : -1;
+	else
+		newer = (first.st_mtim.tv_nsec > second.st_mtim.tv_nsec) -
+			(first.st_mtim.tv_nsec < second.st_mtim.tv_nsec);
+
+	return (!((op == 'n') ? newer > 0 : newer < 0));
+}
+
+/**
+ * binary_op - looks up a binary operator of the test builtin
+ * @op: the operator, e.g. "-eq"
+ *
+ * Return: the index of the operator in the table below, else -1 if @op
+ * isn't a binary operator
+ */
+int binary_op(const char *op)
+{
+	const char *ops[] = {"=", "!=", "<", ">", "-ef", "-nt", "-ot", "-eq",
+		"-ne", "-lt", "-le", "-gt", "-ge", NULL};
+	int i;
+
+	for (i = 0; ops[i] != NULL; i++)
+		if (!_strcmp(op, ops[i]))
+			return (i);
+
+	return (-1);
+}
+
+/**
+ * test_binary - evaluates a binary operator of the test builtin
+ * @msh: contains all the data relevant to the shell's operation
+ * @left: the first operand
+ * @op: the operator, see binary_op()
+ * @right: the second operand
+ *
+ * Return: 0 if the test is true, 1 if it is false, else 2 if an operand of
+ * an integer operator isn't an integer
+ */
+int test_binary(shell_t *msh, const char *left, const char *op,
+		const char *right)
+{
+	const char *operands[2];
+	intmax_t values[2];
+	char *end;
+	int i = binary_op(op), j;
+
+	if (i < 2)
+		return (!_strcmp(left, right) == (i == 1));
+	if (i < 4)
+		return (!((i == 2) ? strcoll(left, right) < 0
+					: strcoll(left, right) > 0));
+	if (i < 7)
+		return (test_files(left, op[1], right));
+
+	operands[0] = left;
+	operands[1] = right;
+	for (j = 0; j < 2; j++)
+	{
+		errno = 0;
+		values[j] = strtoimax(operands[j], &end, 10);
+		while (isblank(*end))
+			end++;
+		if (end == operands[j] || *end != '\0' || errno != 0)
+		{
+			print_error(msh, "%s: Illegal number: %s\n",
+					msh->sub_command[0], operands[j]);
+			return (2);
+		}
+	}
+	j = (values[0] > values[1]) - (values[0] < values[1]);
+
+	return (!((i == 7 && j == 0) || (i == 8 && j != 0) ||
+				(i == 9 && j < 0) || (i == 10 && j <= 0) ||
+				(i == 11 && j > 0) || (i == 12 && j >= 0)));
+}
@@ -0,0 +1,168 @@
+#include "shell.h"
+
+/* the resources used by the children of the shell that were waited for */
+static struct rusage child_usage;
+
+/**
+ * add_child_usage - counts the resources used by a child that terminated
+ * @usage: the resources used by the child, as returned by wait4()
+ *
+ * Description: Times add up, the largest resident set size is kept.
+ */
+void add_child_usage(const struct rusage *usage)
+{
+	timeradd(&child_usage.ru_utime, &usage->ru_utime, &child_usage.ru_utime);
+	timeradd(&child_usage.ru_stime, &usage->ru_stime, &child_usage.ru_stime);
+	child_usage.ru_majflt += usage->ru_majflt;
+	child_usage.ru_minflt += usage->ru_minflt;
+	if (usage->ru_maxrss > child_usage.ru_maxrss)
+		child_usage.ru_maxrss = usage->ru_maxrss;
+}
+
+/**
+ * put_time - appends a duration to a buffer
+ * @buf: the buffer
+ * @seconds: the duration, in seconds
+ * @precision: the number of decimals, at most 3
+ * @long_form: true for the minutes and seconds form, e.g. 1m2.500s
+ *
+ * Return: 0 on success, else -1 if memory allocation failed
+ */
+static int put_time(buffer_t *buf, double seconds, int precision,
+		int long_form)
+{
+	char number[64];
+	long minutes = (long)seconds / 60;
+
+	if (long_form)
+		sprintf(number, "%ldm%.*fs", minutes, precision, seconds - minutes * 60);
+	else
+		sprintf(number, "%.*f", precision, seconds);
+
+	return (buffer_write(buf, number, _strlen(number)));
+}
+
+/**
+ * put_field - appends a field of TIMEFORMAT to a buffer
+ * @buf: the buffer
+ * @times: what the command used
+ * @spec: the field, right after its '%'
+ *
+ * Description: %[p][l]R, %[p][l]U and %[p][l]S are the elapsed, user and
+ * system times with p decimals, %P the CPU usage in percents, %M the largest
+ * resident set size in KiB, %F and %f the major and minor page faults. An
+ * unknown field stands for itself.
+ *
+ * Return: a pointer past the field, else NULL if memory allocation failed
+ */
+static const char *put_field(buffer_t *buf, const cmd_times_t *times,
+		const char *spec)
+{
+	const char *start = spec;
+	char number[64];
+	int precision = 3, long_form, error = 0;
+
+	if (isdigit(*spec))
+		precision = *spec++ - '0';
+	if (precision > 3)
+		precision = 3;
+	long_form = (*spec == 'l');
+	spec += long_form;
+
+	if (*spec == 'R' || *spec == 'U' || *spec == 'S')
+		error = put_time(buf, (*spec == 'R') ? times->real : (*spec == 'U') ?
+				times->user : times->sys, precision, long_form);
+	else if (*spec == 'P')
+	{
+		sprintf(number, "%.*f", precision, (times->real > 0) ?
+				(times->user + times->sys) * 100 / times->real : 0.0);
+		error = buffer_write(buf, number, _strlen(number));
+	}
+	else if (*spec == 'M' || *spec == 'F' || *spec == 'f')
+	{
+		_itoa((*spec == 'M') ? times->max_rss : (*spec == 'F') ?
+				times->major_faults : times->minor_faults, number);
+		error = buffer_write(buf, number, _strlen(number));
+	}
+	else if (*spec == '%')
+		error = buffer_putc(buf, '%');
+	else
+		return ((buffer_putc(buf, '%') == -1) ? NULL : start);
+
+	return ((error == -1) ? NULL : spec + 1);
+}
+
+/**
+ * print_times - reports what a timed command used on the standard error
+ * @times: what the command used
+ *
+ * Description: The report follows TIMEFORMAT, or TIME_FORMAT if it isn't
+ * set. An empty TIMEFORMAT turns the report off.
+ */
+static void print_times(const cmd_times_t *times)
+{
+	const char *format = _getenv("TIMEFORMAT");
+	buffer_t buf = {NULL, 0, 0};
+
+	if (format == NULL)
+		format = TIME_FORMAT;
+	while (format != NULL && *format != '\0')
+	{
+		if (*format == '%')
+			format = put_field(&buf, times, format + 1);
+		else if (buffer_putc(&buf, *format++) == -1)
+			format = NULL;
+	}
+
+	fflush(stdout);
+	if (format != NULL && buf.len > 0 && buffer_putc(&buf, '\n') == 0 &&
+			write(STDERR_FILENO, buf.data, buf.len) == -1)
+		perror("time");
+	safe_free(buf.data);
+}
+
+/**
+ * time_command - runs a command list and reports the time and the memory it
+ * used (the `time` keyword)
+ * @msh: contains all the data relevant to the shell's operation
+ * @list: the command list, NULL to report nothing used
+ *
+ * Description: The children are accounted for as they are waited for, see
+ * wait_command(), and the builtins with the resources used by the shell
+ * itself, so nothing extra is forked.
+ *
+ * Return: the exit code of the list
+ */
+int time_command(shell_t *msh, node_t *list)
+{
+	struct rusage self, now, children = child_usage;
+	struct timespec start, end;
+	cmd_times_t times;
+
+	child_usage.ru_maxrss = 0; /* the largest child of this list only */
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	getrusage(RUSAGE_SELF, &self);
+	if (list != NULL)
+		execute_tree(msh, list);
+	getrusage(RUSAGE_SELF, &now);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	times.real = (end.tv_sec - start.tv_sec) +
+		(end.tv_nsec - start.tv_nsec) / 1e9;
+	times.user = TV_SECONDS(now.ru_utime) - TV_SECONDS(self.ru_utime) +
+		TV_SECONDS(child_usage.ru_utime) - TV_SECONDS(children.ru_utime);
+	times.sys = TV_SECONDS(now.ru_stime) - TV_SECONDS(self.ru_stime) +
+		TV_SECONDS(child_usage.ru_stime) - TV_SECONDS(children.ru_stime);
+	times.max_rss = (child_usage.ru_maxrss > 0) ? child_usage.ru_maxrss
+		: now.ru_maxrss;
+	times.major_faults = now.ru_majflt - self.ru_majflt +
+		child_usage.ru_majflt - children.ru_majflt;
+	times.minor_faults = now.ru_minflt - self.ru_minflt +
+		child_usage.ru_minflt - children.ru_minflt;
+	if (children.ru_maxrss > child_usage.ru_maxrss)
+		child_usage.ru_maxrss = children.ru_maxrss;
+
+	print_times(&times);
+
+	return (msh->exit_code);
+}
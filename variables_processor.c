@@ -1,52 +1,215 @@
 #include "shell.h"
 
+static char expanded[1]; /* stands for a word written to msh->expansion */
+
 /**
- * handle_variables - handles variables passed to the shell
+ * get_param - looks up the parameter named at the start of a string
  * @msh: shell data
+ * @name: the name of the parameter, right after the '$' or the '{'
+ * @value: where to store the value of the parameter, NULL if it isn't set
+ * @buffer: where to write the value of the special parameters ($$, $? and $!)
  *
- * Return: the updated command with variables expanded if one was found, else
- * the @command is returned as received with no modifications
+ * Return: the length of the name, else 0 if @name doesn't start with one
  */
-char **handle_variables(shell_t *msh)
+size_t get_param(shell_t *msh, const char *name, const char **value,
+		char *buffer)
 {
-	size_t i;
-	ssize_t offset;
-	char *value, *loc, result[32];
+	size_t len = 0;
+	var_t *var;
+
+	*value = buffer;
+	*buffer = '\0';
+	if (*name == '$' || *name == '?' || *name == '!')
+	{
+		if (*name == '$')
+			_itoa(getpid(), buffer); /* what's my PID? */
+		else if (*name == '?')
+			_itoa(msh->exit_code, buffer); /* the exit code of the last process */
+		else if (msh->last_bg_pid > 0)
+			_itoa(msh->last_bg_pid, buffer); /* the last background command */
+		return (1);
+	}
 
-	for (i = 0; msh->sub_command[i] != NULL; i++)
+	while (name[len] == '_' || isalpha(name[len]) ||
+			(len > 0 && isdigit(name[len])))
+		len++;
+	if (len > 0)
 	{
-		loc = _strchr(msh->sub_command[i], '$');
-		if (loc == NULL)
-			/* no variables found yet? keep, searching till the end */
+		var = find_var(name, len);
+		*value = (var == NULL) ? NULL : var->entry + len + 1;
+	}
+
+	return (len);
+}
+
+/**
+ * braced_length - returns the length of a ${...} parameter expansion or of a
+ * $(...) command substitution
+ * @param: the expansion, starting with its '$'
+ *
+ * Description: Quoted strings, escaped characters and nested expansions
+ * don't end the expansion, so `${x:-"}"}` and `$(echo ")")` are single ones.
+ *
+ * Return: the length of the expansion, braces included, else 0 if it isn't
+ * terminated
+ */
+size_t braced_length(const char *param)
+{
+	size_t i, len;
+	char quote = '\0', close = (param[1] == '(') ? ')' : '}';
+
+	for (i = 2; param[i] != close || quote != '\0'; i++)
+	{
+		if (param[i] == '\0')
+			return (0);
+		if (param[i] == '\\' && quote != '\'' && param[i + 1] != '\0')
+			i++;
+		else if (param[i] == quote)
+			quote = '\0';
+		else if (quote == '\0' && isquote(param[i]))
+			quote = param[i];
+		else if (quote != '\'' && isbraced(param + i))
+		{
+			len = braced_length(param + i);
+			if (len == 0)
+				return (0);
+			i += len - 1;
+		}
+	}
+
+	return (i + 1);
+}
+
+/**
+ * put_char - appends a character of a word to the expansion buffer
+ * @buf: the expansion buffer
+ * @c: the character
+ * @literal: true if @c was quoted or escaped and the word is a pattern, in
+ * which case the characters special to patterns are escaped
+ *
+ * Return: 0 on success, else -1 if memory allocation failed
+ */
+static int put_char(buffer_t *buf, char c, int literal)
+{
+	if (literal && _strchr("*?[\\", c) != NULL && buffer_putc(buf, '\\') == -1)
+		return (-1);
+
+	return (buffer_putc(buf, c));
+}
+
+/**
+ * expand_text - expands the parameters of a word and removes its quotes, in
+ * a single pass, appending the result to msh->expansion
+ * @msh: shell data
+ * @text: the word, as written on the command line
+ * @end: the character ending the word, '\0' for a whole word and '}' for the
+ * word of a ${...} expansion
+ * @quoted: set to 1 if the word has quotes or backslashes
+ * @pattern: true if the word is a pattern, see put_char()
+ *
+ * Description: Nothing is special inside single quotes. Inside double quotes,
+ * parameters are expanded and a backslash only escapes '$', '`', '"', '\' and
+ * newlines. Outside of quotes, a backslash escapes any character.
+ *
+ * Return: a pointer to the end of the word in @text, else NULL on a bad
+ * substitution or if memory allocation failed
+ */
+const char *expand_text(shell_t *msh, const char *text, char end, int *quoted,
+		int pattern)
+{
+	const char *next;
+	char quote = '\0';
+	int literal;
+
+	for (; *text != end || quote != '\0'; text++)
+	{
+		if (*text == '\0')
+			return (NULL); /* a ${...} expansion isn't terminated */
+		if (*text == quote || (quote == '\0' && isquote(*text)))
+		{
+			quote = (quote == '\0') ? *text : '\0';
+			*quoted = 1;
 			continue;
+		}
+		literal = pattern && quote != '\0';
+		if (*text == '\\' && quote != '\'' && text[1] != '\0' &&
+				(quote == '\0' || _strchr("$`\"\\\n", text[1]) != NULL))
+		{
+			*quoted = 1;
+			literal = pattern;
+			text++; /* the next character stands for itself */
+		}
+		else if (*text == '$' && quote != '\'')
+		{
+			next = expand_param(msh, text + 1, quoted);
+			if (next == NULL)
+				return (NULL);
+			if (next != text + 1)
+			{
+				text = next - 1;
+				continue;
+			}
+		}
+		if (put_char(&msh->expansion, *text, literal) == -1)
+			return (NULL);
+	}
 
-		offset = (&loc[0]) - (&msh->sub_command[i][0]);
+	return (text);
+}
 
-		if (msh->sub_command[i][offset + 1] == '\0')
-			continue; /* this is just a literal '$' sign, ignore it */
+/**
+ * handle_variables - expands the words of the command being run
+ * @msh: shell data
+ *
+ * Description: Only the words with quotes, backslashes or parameters are
+ * expanded, one after the other into msh->expansion; the others are used as
+ * they are. A word that expands to nothing is dropped, unless it was quoted.
+ * A failed allocation is reported with the system's message rather than as a
+ * bad substitution, the expansion functions only return NULL either way.
+ *
+ * Return: the expanded words, msh->sub_command, else NULL on a bad
+ * substitution or if memory allocation failed
+ */
+char **handle_variables(shell_t *msh)
+{
+	char **words = msh->sub_command, *word;
+	size_t i, j, start;
+	int quoted;
 
-		/* what's my PID? that's what this guy tells you */
-		if (msh->sub_command[i][offset + 1] == '$')
+	msh->expansion.len = 0;
+	for (i = j = 0; words[i] != NULL; i++)
+	{
+		if (_strpbrk(words[i], "'\"\\$") == NULL)
 		{
-			_itoa(getpid(), result);
-			safe_free(msh->sub_command[i]);
-			msh->sub_command[i] = _strdup(result);
+			words[j++] = words[i];
+			continue;
 		}
-		/* this is for when the user wants the exit code of the last process */
-		else if (msh->sub_command[i][offset + 1] == '?')
+		start = msh->expansion.len;
+		quoted = 0;
+		errno = 0; /* tells allocation failures from bad substitutions */
+		if (expand_text(msh, words[i], '\0', &quoted, 0) == NULL ||
+				buffer_putc(&msh->expansion, '\0') == -1)
 		{
-			_itoa(msh->exit_code, result);
-			safe_free(msh->sub_command[i]);
-			msh->sub_command[i] = _strdup(result);
+			if (errno == ENOMEM)
+				perror(msh->prog_name);
+			else
+				print_error(msh, "Bad substitution\n");
+			return (msh->exit_code = CMD_ERR, NULL);
 		}
-		/* this is for when something like '$HOSTNAME' is received */
+		if (msh->expansion.len - start == 1 && !quoted)
+			msh->expansion.len = start; /* expanded to nothing, dropped */
 		else
+			words[j++] = expanded;
+	}
+	words[j] = NULL;
+
+	/* the buffer may have moved while growing, point at the words last */
+	for (i = 0, word = msh->expansion.data; i < j; i++)
+		if (words[i] == expanded)
 		{
-			value = _getenv(loc + 1);
-			safe_free(msh->sub_command[i]);
-			msh->sub_command[i] = _strdup(value);
+			words[i] = word;
+			word += _strlen(word) + 1;
 		}
-	}
 
-	return (msh->sub_command);
+	return (words);
 }